@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+#include <benchmark/benchmark.h>
+
+#include <action_spaces.h>
+#include <rcu.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // The lookup done by xrLocateSpace() for every space the application locates, with a session holding a few
+    // controller spaces and one eye gaze space. The located spaces are never eye gaze spaces, the common case.
+
+    template <typename Handle>
+    Handle MakeHandle(uint64_t value) {
+        if constexpr (std::is_pointer_v<Handle>) {
+            return reinterpret_cast<Handle>(static_cast<uintptr_t>(value));
+        } else {
+            return static_cast<Handle>(value);
+        }
+    }
+
+    constexpr uint64_t SpaceCount = 8;
+    const XrAction GazeAction = MakeHandle<XrAction>(1);
+    const XrAction ControllerAction = MakeHandle<XrAction>(2);
+
+    ActionsAndSpaces MakeActionsAndSpaces() {
+        ActionsAndSpaces actionsAndSpaces;
+        actionsAndSpaces.eyeGazeActions.insert(GazeAction);
+        for (uint64_t i = 0; i < SpaceCount; i++) {
+            actionsAndSpaces.actionSpaces.insert_or_assign(
+                MakeHandle<XrSpace>(100 + i),
+                ActionSpace{i == 0 ? GazeAction : ControllerAction, {{0.f, 0.f, 0.f, 1.f}, {0.f, 0.f, 0.f}}});
+        }
+        actionsAndSpaces.updateEyeGazeSpaces();
+        return actionsAndSpaces;
+    }
+
+    // The former lookup: both spaces looked up in the action space map, under a mutex.
+    void BM_LocateLookupMutexMap(benchmark::State& state) {
+        static std::mutex mutex;
+        static const ActionsAndSpaces actionsAndSpaces = MakeActionsAndSpaces();
+        uint64_t i = 0;
+        for (auto _ : state) {
+            std::unique_lock lock(mutex);
+            const auto space = actionsAndSpaces.actionSpaces.find(MakeHandle<XrSpace>(101 + i++ % (SpaceCount - 1)));
+            const auto base = actionsAndSpaces.actionSpaces.find(MakeHandle<XrSpace>(1));
+            const bool isEyeGaze = (space != actionsAndSpaces.actionSpaces.end() &&
+                                    actionsAndSpaces.eyeGazeActions.count(space->second.action)) ||
+                                   (base != actionsAndSpaces.actionSpaces.end() &&
+                                    actionsAndSpaces.eyeGazeActions.count(base->second.action));
+            benchmark::DoNotOptimize(isEyeGaze);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_LocateLookupMutexMap)->ThreadRange(1, 4)->UseRealTime();
+
+    // With the lock-free snapshot, scanning the array of eye gaze spaces.
+    void BM_LocateLookupRcuScan(benchmark::State& state) {
+        static RcuValue<ActionsAndSpaces> rcu;
+        if (state.thread_index() == 0) {
+            rcu.update([](ActionsAndSpaces& actionsAndSpaces) { actionsAndSpaces = MakeActionsAndSpaces(); });
+        }
+        uint64_t i = 0;
+        for (auto _ : state) {
+            const auto actionsAndSpaces = rcu.read();
+            XrPosef pose;
+            const bool isEyeGaze =
+                actionsAndSpaces->findEyeGazeSpace(MakeHandle<XrSpace>(101 + i++ % (SpaceCount - 1)), pose) ||
+                actionsAndSpaces->findEyeGazeSpace(MakeHandle<XrSpace>(1), pose);
+            benchmark::DoNotOptimize(isEyeGaze);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_LocateLookupRcuScan)->ThreadRange(1, 4)->UseRealTime();
+
+    // Without any eye gaze space, xrLocateSpace() only checks a flag.
+    void BM_LocateLookupNoEyeGazeSpace(benchmark::State& state) {
+        static std::atomic<bool> hasEyeGazeSpaces{false};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(hasEyeGazeSpaces.load(std::memory_order_acquire));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_LocateLookupNoEyeGazeSpace)->ThreadRange(1, 4)->UseRealTime();
+
+    // A downstream runtime that returns immediately, reached through a function pointer like the layer's dispatch.
+    // Its result depends on the space, so that the call cannot be elided.
+    int MockDownstreamLocateSpace(XrSpace space, XrSpace baseSpace, XrPosef* pose) {
+        pose->position.x = (float)reinterpret_cast<uintptr_t>(space);
+        return space == baseSpace ? -1 : 0;
+    }
+
+    // A whole xrLocateSpace() call for a space that is not an eye gaze space, forwarded to the mock runtime: directly
+    // without the layer, with the former lookup, and with the lookup through the snapshot. The difference with the
+    // direct call is the per-call overhead of the layer. The overhead measured with the real layer is reported by
+    // layer-benchmarks on Windows.
+    void BM_LocateNonEyeGazeSpace(benchmark::State& state) {
+        static std::mutex mutex;
+        static const ActionsAndSpaces actionsAndSpaces = MakeActionsAndSpaces();
+        static RcuValue<ActionsAndSpaces> rcu;
+        static std::atomic<bool> hasEyeGazeSpaces{true};
+        if (state.thread_index() == 0) {
+            rcu.update([](ActionsAndSpaces& actionsAndSpaces) { actionsAndSpaces = MakeActionsAndSpaces(); });
+        }
+        static const char* const Labels[] = {"Direct", "Mutex and map", "Snapshot"};
+        state.SetLabel(Labels[state.range(0)]);
+
+        int (*volatile downstream)(XrSpace, XrSpace, XrPosef*) = MockDownstreamLocateSpace;
+        const XrSpace baseSpace = MakeHandle<XrSpace>(1);
+        uint64_t i = 0;
+        for (auto _ : state) {
+            const XrSpace space = MakeHandle<XrSpace>(101 + i++ % (SpaceCount - 1));
+            bool isEyeGaze = false;
+            if (state.range(0) == 1) {
+                std::unique_lock lock(mutex);
+                const auto it = actionsAndSpaces.actionSpaces.find(space);
+                const auto baseIt = actionsAndSpaces.actionSpaces.find(baseSpace);
+                isEyeGaze = (it != actionsAndSpaces.actionSpaces.end() &&
+                             actionsAndSpaces.eyeGazeActions.count(it->second.action)) ||
+                            (baseIt != actionsAndSpaces.actionSpaces.end() &&
+                             actionsAndSpaces.eyeGazeActions.count(baseIt->second.action));
+            } else if (state.range(0) == 2 && hasEyeGazeSpaces.load(std::memory_order_acquire)) {
+                const auto snapshot = rcu.read();
+                XrPosef pose;
+                isEyeGaze = snapshot->findEyeGazeSpace(space, pose) || snapshot->findEyeGazeSpace(baseSpace, pose);
+            }
+
+            XrPosef pose;
+            benchmark::DoNotOptimize(isEyeGaze);
+            benchmark::DoNotOptimize(downstream(space, baseSpace, &pose));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_LocateNonEyeGazeSpace)->Arg(0)->Arg(1)->Arg(2)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
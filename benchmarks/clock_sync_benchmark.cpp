@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <atomic>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <clock_sync.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // A tracker clock 1us ahead of the local clock, read within a 10us bracket.
+    void FillWindow(ClockCorrelation& correlation) {
+        for (int64_t local = 0; local < 2'000'000'000; local += ClockCorrelation::FastSamplingPeriod) {
+            correlation.addSample(local, local + 1000, local + 10'000);
+        }
+    }
+
+    // Converting a tracker timestamp, done for every sample.
+    void BM_ClockCorrelationToLocal(benchmark::State& state) {
+        ClockCorrelation correlation;
+        FillWindow(correlation);
+        int64_t remote = 2'000'001'000;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(correlation.toLocal(remote++));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ClockCorrelationToLocal);
+
+    // Converting a requested XrTime, done for every query to a tracker reading its own clock.
+    void BM_ClockCorrelationToRemote(benchmark::State& state) {
+        ClockCorrelation correlation;
+        FillWindow(correlation);
+        int64_t local = 2'000'000'000;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(correlation.toRemote(local++));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ClockCorrelationToRemote);
+
+    // Adding a pair of readings refits the whole window, which happens at most every 100ms.
+    void BM_ClockCorrelationAddSample(benchmark::State& state) {
+        ClockCorrelation correlation;
+        FillWindow(correlation);
+        int64_t local = 2'000'000'000;
+        for (auto _ : state) {
+            correlation.addSample(local, local + 1000, local + 10'000);
+            local += ClockCorrelation::SlowSamplingPeriod;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_ClockCorrelationAddSample);
+
+    // Conversions from the application threads while a tracker thread refits as fast as it can, the worst case for
+    // the readers of the fit.
+    void BM_ClockCorrelationToLocalWhileSampling(benchmark::State& state) {
+        static ClockCorrelation correlation;
+        static std::atomic<bool> stop;
+        static std::thread sampler;
+        if (state.thread_index() == 0) {
+            correlation.reset();
+            FillWindow(correlation);
+            stop = false;
+            sampler = std::thread([] {
+                for (int64_t local = 2'000'000'000; !stop.load(std::memory_order_relaxed);
+                     local += ClockCorrelation::SlowSamplingPeriod) {
+                    correlation.addSample(local, local + 1000, local + 10'000);
+                }
+            });
+        }
+
+        int64_t remote = 2'000'001'000;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(correlation.toLocal(remote++));
+        }
+        state.SetItemsProcessed(state.iterations());
+
+        if (state.thread_index() == 0) {
+            stop = true;
+            sampler.join();
+        }
+    }
+    BENCHMARK(BM_ClockCorrelationToLocalWhileSampling)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,120 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include <gaze_history.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // A tracker running at 200Hz.
+    constexpr XrDuration SamplePeriod = 5'000'000;
+
+    // The index-th sample of a slow horizontal sweep, the yaw going back and forth.
+    GazeSample SweepSample(uint64_t index) {
+        const float yaw = 0.4f * std::sin(index * 0.01f);
+
+        GazeSample sample;
+        sample.time = (XrTime)(index + 1) * SamplePeriod;
+        sample.unitVector = {std::sin(yaw), 0.f, -std::cos(yaw)};
+        for (uint32_t eye = 0; eye < EyeCount; eye++) {
+            sample.eyeUnitVector[eye] = sample.unitVector;
+        }
+        sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+        sample.isValid = true;
+        return sample;
+    }
+
+    // The cost on the tracker thread for each new sample.
+    void BM_GazeHistoryPush(benchmark::State& state) {
+        GazeHistory<> history;
+        uint64_t index = 0;
+        for (auto _ : state) {
+            history.push(SweepSample(index++));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_GazeHistoryPush);
+
+    // Query the gaze a given number of samples in the past, which walks back the history and interpolates.
+    void BM_GazeHistorySample(benchmark::State& state) {
+        GazeHistory<> history;
+        uint64_t index = 0;
+        for (; index < 64; index++) {
+            history.push(SweepSample(index));
+        }
+        const XrTime queryTime = (XrTime)index * SamplePeriod - state.range(0) * SamplePeriod - SamplePeriod / 2;
+        for (auto _ : state) {
+            GazeSample sample;
+            benchmark::DoNotOptimize(history.sample(queryTime, sample));
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_GazeHistorySample)->Arg(0)->Arg(4)->Arg(32);
+
+    // Queries from the application threads while the tracker thread keeps pushing samples.
+    void BM_GazeHistorySampleWhilePushing(benchmark::State& state) {
+        static std::unique_ptr<GazeHistory<>> history;
+        static std::atomic<uint64_t> latestIndex;
+        static std::atomic<bool> stop;
+        static std::thread producer;
+        if (state.thread_index() == 0) {
+            history = std::make_unique<GazeHistory<>>();
+            for (uint64_t index = 0; index < 64; index++) {
+                history->push(SweepSample(index));
+            }
+            latestIndex = 63;
+            stop = false;
+            producer = std::thread([] {
+                for (uint64_t index = 64; !stop.load(std::memory_order_relaxed); index++) {
+                    history->push(SweepSample(index));
+                    latestIndex.store(index, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        uint64_t found = 0;
+        for (auto _ : state) {
+            // Between the two latest samples that the producer published.
+            const uint64_t index = latestIndex.load(std::memory_order_relaxed);
+            const XrTime queryTime = (XrTime)index * SamplePeriod + SamplePeriod / 2;
+            GazeSample sample;
+            found += history->sample(queryTime, sample);
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["Found"] = benchmark::Counter((double)found, benchmark::Counter::kAvgIterations);
+
+        if (state.thread_index() == 0) {
+            stop = true;
+            producer.join();
+            history.reset();
+        }
+    }
+    BENCHMARK(BM_GazeHistorySampleWhilePushing)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
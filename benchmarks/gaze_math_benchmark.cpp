@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gaze_math.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    std::vector<XrVector3f> MakeGazes() {
+        std::mt19937 random(5);
+        std::uniform_real_distribution<float> angle(-0.6f, 0.6f);
+        std::vector<XrVector3f> gazes(1024);
+        for (auto& gaze : gazes) {
+            gaze = gaze::Normalize(XrVector3f{std::tan(angle(random)), std::tan(angle(random)), -1.f});
+        }
+        return gazes;
+    }
+
+    XrQuaternionf AxisAngle(const XrVector3f& axis, float angle) {
+        return {axis.x * std::sin(angle / 2), axis.y * std::sin(angle / 2), axis.z * std::sin(angle / 2),
+                std::cos(angle / 2)};
+    }
+
+    // The former orientation, built from approximated pitch and yaw angles.
+    XrQuaternionf OrientationRollPitchYaw(const XrVector3f& gaze) {
+        return gaze::Multiply(AxisAngle({1.f, 0.f, 0.f}, std::tan(gaze.y)),
+                              AxisAngle({0.f, 1.f, 0.f}, -std::tan(gaze.x)));
+    }
+
+    // The largest angle (degrees) between the gazes and where the orientations built from them look.
+    template <typename Orientation>
+    double MaxErrorDeg(const std::vector<XrVector3f>& gazes, Orientation orientation) {
+        float maxError = 0.f;
+        for (const auto& gaze : gazes) {
+            const XrVector3f forward = gaze::Rotate({0.f, 0.f, -1.f}, orientation(gaze));
+            // Not acos(), which is too coarse in single precision for the smallest errors.
+            const XrVector3f cross = gaze::Cross(forward, gaze);
+            maxError = std::max(maxError, std::atan2(std::sqrt(gaze::Dot(cross, cross)), gaze::Dot(forward, gaze)));
+        }
+        return maxError * 180.0 / 3.14159265;
+    }
+
+    void BM_OrientationRollPitchYaw(benchmark::State& state) {
+        const auto gazes = MakeGazes();
+        size_t i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(OrientationRollPitchYaw(gazes[i++ % gazes.size()]));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["MaxErrorDeg"] = MaxErrorDeg(gazes, OrientationRollPitchYaw);
+    }
+    BENCHMARK(BM_OrientationRollPitchYaw);
+
+    void BM_OrientationShortestArc(benchmark::State& state) {
+        const auto gazes = MakeGazes();
+        size_t i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(gaze::OrientationFromUnitVector(gazes[i++ % gazes.size()]));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["MaxErrorDeg"] = MaxErrorDeg(gazes, gaze::OrientationFromUnitVector);
+    }
+    BENCHMARK(BM_OrientationShortestArc);
+
+    void BM_Slerp(benchmark::State& state) {
+        const auto gazes = MakeGazes();
+        std::vector<XrQuaternionf> orientations;
+        for (const auto& gaze : gazes) {
+            orientations.push_back(gaze::OrientationFromUnitVector(gaze));
+        }
+        size_t i = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(
+                gaze::Slerp(orientations[i % orientations.size()], orientations[(i + 1) % orientations.size()], 0.3f));
+            i++;
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Slerp);
+
+} // namespace
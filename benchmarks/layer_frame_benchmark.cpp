@@ -0,0 +1,400 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "runtime_standin.h"
+
+// Runs an application frame loop against the stand-in runtime, once directly and once through the layer built by the
+// Visual Studio solution, to measure what the layer adds to each frame.
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    void CheckXrResult(XrResult result, const char* call) {
+        if (XR_FAILED(result)) {
+            throw std::runtime_error(std::string(call) + " failed with " + std::to_string(result));
+        }
+    }
+
+#define CHECK_XR(call) CheckXrResult((call), #call)
+
+    // The layer DLL can be overridden, eg: to benchmark the 32-bit build.
+    std::filesystem::path GetLayerPath() {
+        if (const char* path = std::getenv("XR_EYE_TRACKERS_LAYER_PATH")) {
+            return path;
+        }
+        return LAYER_PATH;
+    }
+
+    XrInstanceCreateInfo MakeInstanceCreateInfo() {
+        static const char* const extensions[] = {XR_EXT_EYE_GAZE_INTERACTION_EXTENSION_NAME};
+
+        XrInstanceCreateInfo createInfo{XR_TYPE_INSTANCE_CREATE_INFO};
+        strcpy(createInfo.applicationInfo.applicationName, "layer-benchmarks");
+        createInfo.applicationInfo.apiVersion = XR_CURRENT_API_VERSION;
+        createInfo.enabledExtensionCount = (uint32_t)std::size(extensions);
+        createInfo.enabledExtensionNames = extensions;
+        return createInfo;
+    }
+
+    // Play the part of the loader: negotiate with the layer, and chain the stand-in runtime behind it.
+    PFN_xrGetInstanceProcAddr CreateLayeredInstance(XrInstance& instance) {
+        const HMODULE layer = LoadLibraryW(GetLayerPath().c_str());
+        if (!layer) {
+            throw std::runtime_error("Failed to load " + GetLayerPath().string());
+        }
+        const auto xrNegotiateLoaderApiLayerInterface = reinterpret_cast<PFN_xrNegotiateLoaderApiLayerInterface>(
+            GetProcAddress(layer, "xrNegotiateLoaderApiLayerInterface"));
+        if (!xrNegotiateLoaderApiLayerInterface) {
+            throw std::runtime_error("The layer does not export xrNegotiateLoaderApiLayerInterface");
+        }
+
+        XrNegotiateLoaderInfo loaderInfo{XR_LOADER_INTERFACE_STRUCT_LOADER_INFO,
+                                         XR_LOADER_INFO_STRUCT_VERSION,
+                                         sizeof(XrNegotiateLoaderInfo)};
+        loaderInfo.minInterfaceVersion = loaderInfo.maxInterfaceVersion = XR_CURRENT_LOADER_API_LAYER_VERSION;
+        loaderInfo.minApiVersion = loaderInfo.maxApiVersion = XR_CURRENT_API_VERSION;
+        XrNegotiateApiLayerRequest layerRequest{XR_LOADER_INTERFACE_STRUCT_API_LAYER_REQUEST,
+                                                XR_API_LAYER_INFO_STRUCT_VERSION,
+                                                sizeof(XrNegotiateApiLayerRequest)};
+        CHECK_XR(xrNegotiateLoaderApiLayerInterface(&loaderInfo, LAYER_NAME, &layerRequest));
+
+        XrApiLayerNextInfo nextInfo{XR_LOADER_INTERFACE_STRUCT_API_LAYER_NEXT_INFO,
+                                    XR_API_LAYER_NEXT_INFO_STRUCT_VERSION,
+                                    sizeof(XrApiLayerNextInfo)};
+        strcpy(nextInfo.layerName, LAYER_NAME);
+        nextInfo.nextGetInstanceProcAddr = standin::xrGetInstanceProcAddr;
+        nextInfo.nextCreateApiLayerInstance = standin::xrCreateApiLayerInstance;
+        XrApiLayerCreateInfo apiLayerInfo{XR_LOADER_INTERFACE_STRUCT_API_LAYER_CREATE_INFO,
+                                          XR_API_LAYER_CREATE_INFO_STRUCT_VERSION,
+                                          sizeof(XrApiLayerCreateInfo)};
+        apiLayerInfo.nextInfo = &nextInfo;
+
+        const XrInstanceCreateInfo createInfo = MakeInstanceCreateInfo();
+        CHECK_XR(layerRequest.createApiLayerInstance(&createInfo, &apiLayerInfo, &instance));
+        return layerRequest.getInstanceProcAddr;
+    }
+
+    PFN_xrGetInstanceProcAddr CreateDirectInstance(XrInstance& instance) {
+        const XrInstanceCreateInfo createInfo = MakeInstanceCreateInfo();
+        CHECK_XR(standin::xrCreateApiLayerInstance(&createInfo, nullptr, &instance));
+        return standin::xrGetInstanceProcAddr;
+    }
+
+    // An application with one eye gaze action space and a few other spaces, rendering nothing.
+    class FrameLoop {
+      public:
+        FrameLoop(bool throughLayer, uint32_t otherSpaceCount) {
+            xrGetInstanceProcAddr =
+                throughLayer ? CreateLayeredInstance(m_instance) : CreateDirectInstance(m_instance);
+
+#define RESOLVE(name) CHECK_XR(xrGetInstanceProcAddr(m_instance, #name, reinterpret_cast<PFN_xrVoidFunction*>(&name)))
+            RESOLVE(xrDestroyInstance);
+            RESOLVE(xrGetSystem);
+            RESOLVE(xrGetSystemProperties);
+            RESOLVE(xrCreateSession);
+            RESOLVE(xrDestroySession);
+            RESOLVE(xrBeginSession);
+            RESOLVE(xrStringToPath);
+            RESOLVE(xrCreateActionSet);
+            RESOLVE(xrCreateAction);
+            RESOLVE(xrSuggestInteractionProfileBindings);
+            RESOLVE(xrAttachSessionActionSets);
+            RESOLVE(xrCreateActionSpace);
+            RESOLVE(xrCreateReferenceSpace);
+            RESOLVE(xrWaitFrame);
+            RESOLVE(xrBeginFrame);
+            RESOLVE(xrEndFrame);
+            RESOLVE(xrSyncActions);
+            RESOLVE(xrGetActionStatePose);
+            RESOLVE(xrLocateSpace);
+#undef RESOLVE
+
+            XrSystemGetInfo systemInfo{XR_TYPE_SYSTEM_GET_INFO};
+            systemInfo.formFactor = XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY;
+            XrSystemId systemId;
+            CHECK_XR(xrGetSystem(m_instance, &systemInfo, &systemId));
+
+            XrSystemEyeGazeInteractionPropertiesEXT eyeGazeProperties{
+                XR_TYPE_SYSTEM_EYE_GAZE_INTERACTION_PROPERTIES_EXT};
+            XrSystemProperties systemProperties{XR_TYPE_SYSTEM_PROPERTIES, &eyeGazeProperties};
+            CHECK_XR(xrGetSystemProperties(m_instance, systemId, &systemProperties));
+            if (throughLayer && !eyeGazeProperties.supportsEyeGazeInteraction) {
+                throw std::runtime_error("The layer did not pick up the eye tracker of the stand-in runtime");
+            }
+
+            XrSessionCreateInfo sessionInfo{XR_TYPE_SESSION_CREATE_INFO};
+            sessionInfo.systemId = systemId;
+            CHECK_XR(xrCreateSession(m_instance, &sessionInfo, &m_session));
+            XrSessionBeginInfo beginInfo{XR_TYPE_SESSION_BEGIN_INFO};
+            beginInfo.primaryViewConfigurationType = XR_VIEW_CONFIGURATION_TYPE_PRIMARY_STEREO;
+            CHECK_XR(xrBeginSession(m_session, &beginInfo));
+
+            XrActionSetCreateInfo actionSetInfo{XR_TYPE_ACTION_SET_CREATE_INFO};
+            strcpy(actionSetInfo.actionSetName, "gameplay");
+            strcpy(actionSetInfo.localizedActionSetName, "Gameplay");
+            CHECK_XR(xrCreateActionSet(m_instance, &actionSetInfo, &m_actionSet));
+            XrActionCreateInfo actionInfo{XR_TYPE_ACTION_CREATE_INFO};
+            actionInfo.actionType = XR_ACTION_TYPE_POSE_INPUT;
+            strcpy(actionInfo.actionName, "gaze");
+            strcpy(actionInfo.localizedActionName, "Gaze");
+            CHECK_XR(xrCreateAction(m_actionSet, &actionInfo, &m_gazeAction));
+
+            XrActionSuggestedBinding binding{m_gazeAction};
+            CHECK_XR(xrStringToPath(m_instance, "/user/eyes_ext/input/gaze_ext/pose", &binding.binding));
+            XrInteractionProfileSuggestedBinding suggestedBindings{XR_TYPE_INTERACTION_PROFILE_SUGGESTED_BINDING};
+            CHECK_XR(xrStringToPath(
+                m_instance, "/interaction_profiles/ext/eye_gaze_interaction", &suggestedBindings.interactionProfile));
+            suggestedBindings.countSuggestedBindings = 1;
+            suggestedBindings.suggestedBindings = &binding;
+            CHECK_XR(xrSuggestInteractionProfileBindings(m_instance, &suggestedBindings));
+
+            XrSessionActionSetsAttachInfo attachInfo{XR_TYPE_SESSION_ACTION_SETS_ATTACH_INFO};
+            attachInfo.countActionSets = 1;
+            attachInfo.actionSets = &m_actionSet;
+            CHECK_XR(xrAttachSessionActionSets(m_session, &attachInfo));
+
+            XrActionSpaceCreateInfo actionSpaceInfo{XR_TYPE_ACTION_SPACE_CREATE_INFO};
+            actionSpaceInfo.action = m_gazeAction;
+            actionSpaceInfo.poseInActionSpace.orientation.w = 1.f;
+            CHECK_XR(xrCreateActionSpace(m_session, &actionSpaceInfo, &m_gazeSpace));
+
+            XrReferenceSpaceCreateInfo referenceSpaceInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
+            referenceSpaceInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_LOCAL;
+            referenceSpaceInfo.poseInReferenceSpace.orientation.w = 1.f;
+            CHECK_XR(xrCreateReferenceSpace(m_session, &referenceSpaceInfo, &m_baseSpace));
+            referenceSpaceInfo.referenceSpaceType = XR_REFERENCE_SPACE_TYPE_VIEW;
+            m_otherSpaces.resize(otherSpaceCount);
+            for (XrSpace& space : m_otherSpaces) {
+                CHECK_XR(xrCreateReferenceSpace(m_session, &referenceSpaceInfo, &space));
+            }
+        }
+
+        ~FrameLoop() {
+            xrDestroySession(m_session);
+            xrDestroyInstance(m_instance);
+        }
+
+        // Returns whether the gaze was located.
+        bool runFrame() {
+            XrFrameWaitInfo waitInfo{XR_TYPE_FRAME_WAIT_INFO};
+            XrFrameState frameState{XR_TYPE_FRAME_STATE};
+            CHECK_XR(xrWaitFrame(m_session, &waitInfo, &frameState));
+            m_time = frameState.predictedDisplayTime;
+            XrFrameBeginInfo beginInfo{XR_TYPE_FRAME_BEGIN_INFO};
+            CHECK_XR(xrBeginFrame(m_session, &beginInfo));
+
+            XrActiveActionSet activeActionSet{m_actionSet, XR_NULL_PATH};
+            XrActionsSyncInfo syncInfo{XR_TYPE_ACTIONS_SYNC_INFO};
+            syncInfo.countActiveActionSets = 1;
+            syncInfo.activeActionSets = &activeActionSet;
+            CHECK_XR(xrSyncActions(m_session, &syncInfo));
+
+            XrActionStateGetInfo getInfo{XR_TYPE_ACTION_STATE_GET_INFO};
+            getInfo.action = m_gazeAction;
+            XrActionStatePose actionState{XR_TYPE_ACTION_STATE_POSE};
+            CHECK_XR(xrGetActionStatePose(m_session, &getInfo, &actionState));
+
+            const bool isGazeValid = actionState.isActive && locate(m_gazeSpace);
+            for (XrSpace space : m_otherSpaces) {
+                locate(space);
+            }
+
+            XrFrameEndInfo endInfo{XR_TYPE_FRAME_END_INFO};
+            endInfo.displayTime = m_time;
+            endInfo.environmentBlendMode = XR_ENVIRONMENT_BLEND_MODE_OPAQUE;
+            CHECK_XR(xrEndFrame(m_session, &endInfo));
+
+            return isGazeValid;
+        }
+
+        // Locate a space at the time of the last frame. Returns whether its orientation is valid.
+        bool locate(XrSpace space) {
+            XrSpaceLocation location{XR_TYPE_SPACE_LOCATION};
+            CHECK_XR(xrLocateSpace(space, m_baseSpace, m_time, &location));
+            return (location.locationFlags & XR_SPACE_LOCATION_ORIENTATION_VALID_BIT) != 0;
+        }
+
+        XrSpace getGazeSpace() const {
+            return m_gazeSpace;
+        }
+
+        XrSpace getOtherSpace() const {
+            return m_otherSpaces.front();
+        }
+
+      private:
+        PFN_xrGetInstanceProcAddr xrGetInstanceProcAddr{nullptr};
+        PFN_xrDestroyInstance xrDestroyInstance{nullptr};
+        PFN_xrGetSystem xrGetSystem{nullptr};
+        PFN_xrGetSystemProperties xrGetSystemProperties{nullptr};
+        PFN_xrCreateSession xrCreateSession{nullptr};
+        PFN_xrDestroySession xrDestroySession{nullptr};
+        PFN_xrBeginSession xrBeginSession{nullptr};
+        PFN_xrStringToPath xrStringToPath{nullptr};
+        PFN_xrCreateActionSet xrCreateActionSet{nullptr};
+        PFN_xrCreateAction xrCreateAction{nullptr};
+        PFN_xrSuggestInteractionProfileBindings xrSuggestInteractionProfileBindings{nullptr};
+        PFN_xrAttachSessionActionSets xrAttachSessionActionSets{nullptr};
+        PFN_xrCreateActionSpace xrCreateActionSpace{nullptr};
+        PFN_xrCreateReferenceSpace xrCreateReferenceSpace{nullptr};
+        PFN_xrWaitFrame xrWaitFrame{nullptr};
+        PFN_xrBeginFrame xrBeginFrame{nullptr};
+        PFN_xrEndFrame xrEndFrame{nullptr};
+        PFN_xrSyncActions xrSyncActions{nullptr};
+        PFN_xrGetActionStatePose xrGetActionStatePose{nullptr};
+        PFN_xrLocateSpace xrLocateSpace{nullptr};
+
+        XrInstance m_instance{XR_NULL_HANDLE};
+        XrSession m_session{XR_NULL_HANDLE};
+        XrActionSet m_actionSet{XR_NULL_HANDLE};
+        XrAction m_gazeAction{XR_NULL_HANDLE};
+        XrSpace m_gazeSpace{XR_NULL_HANDLE};
+        XrSpace m_baseSpace{XR_NULL_HANDLE};
+        std::vector<XrSpace> m_otherSpaces;
+        XrTime m_time{0};
+    };
+
+    constexpr uint32_t OtherSpaceCount = 4;
+
+    // The layer supports a single instance, so both loops are created once and shared by all the benchmarks.
+    struct FrameLoops {
+        std::unique_ptr<FrameLoop> direct;
+        std::unique_ptr<FrameLoop> layered;
+        std::string error;
+    };
+
+    FrameLoops& GetFrameLoops() {
+        static FrameLoops loops = [] {
+            FrameLoops loops;
+            try {
+                loops.direct = std::make_unique<FrameLoop>(false, OtherSpaceCount);
+                loops.layered = std::make_unique<FrameLoop>(true, OtherSpaceCount);
+            } catch (std::exception& exc) {
+                loops.error = exc.what();
+            }
+            return loops;
+        }();
+        return loops;
+    }
+
+    using Clock = std::chrono::steady_clock;
+
+    double ElapsedNs(Clock::time_point start, Clock::time_point end) {
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    }
+
+    // Alternate the frames with and without the layer, so that both see the same conditions. The argument is the
+    // latency of the runtime's eye tracker in microseconds, which only the layer pays.
+    void BM_FrameOverhead(benchmark::State& state) {
+        FrameLoops& loops = GetFrameLoops();
+        if (!loops.error.empty()) {
+            state.SkipWithError(loops.error.c_str());
+            return;
+        }
+
+        standin::RuntimeOptions options;
+        options.eyeGazesLatency = std::chrono::microseconds(state.range(0));
+        standin::SetRuntimeOptions(options);
+
+        double directNs = 0;
+        double layerNs = 0;
+        uint64_t validGazes = 0;
+        const uint64_t eyeGazesCalls = standin::GetRuntimeStatistics().eyeGazesCalls;
+        try {
+            for (auto _ : state) {
+                const auto start = Clock::now();
+                loops.direct->runFrame();
+                const auto middle = Clock::now();
+                validGazes += loops.layered->runFrame();
+                const auto end = Clock::now();
+
+                directNs += ElapsedNs(start, middle);
+                layerNs += ElapsedNs(middle, end);
+            }
+        } catch (std::exception& exc) {
+            state.SkipWithError(exc.what());
+            return;
+        }
+
+        state.counters["DirectNs"] = benchmark::Counter(directNs, benchmark::Counter::kAvgIterations);
+        state.counters["LayerNs"] = benchmark::Counter(layerNs, benchmark::Counter::kAvgIterations);
+        state.counters["OverheadNs"] = benchmark::Counter(layerNs - directNs, benchmark::Counter::kAvgIterations);
+        state.counters["ValidGaze"] = benchmark::Counter((double)validGazes, benchmark::Counter::kAvgIterations);
+        // The gaze action state and the eye gaze space of a frame should share one query to the tracker.
+        state.counters["TrackerQueries"] =
+            benchmark::Counter((double)(standin::GetRuntimeStatistics().eyeGazesCalls - eyeGazesCalls),
+                               benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_FrameOverhead)->ArgName("EyeGazesLatencyUs")->Arg(0)->Arg(100);
+
+    // Locate one space at the time of the last frame, with and without the layer. The argument selects the eye gaze
+    // space, whose sample is cached for the frame, or another space, which the layer only forwards.
+    void BM_LocateSpaceOverhead(benchmark::State& state) {
+        FrameLoops& loops = GetFrameLoops();
+        if (!loops.error.empty()) {
+            state.SkipWithError(loops.error.c_str());
+            return;
+        }
+
+        standin::SetRuntimeOptions({});
+        const bool isGaze = state.range(0);
+        double directNs = 0;
+        double layerNs = 0;
+        try {
+            loops.direct->runFrame();
+            loops.layered->runFrame();
+            const XrSpace directSpace = isGaze ? loops.direct->getGazeSpace() : loops.direct->getOtherSpace();
+            const XrSpace layeredSpace = isGaze ? loops.layered->getGazeSpace() : loops.layered->getOtherSpace();
+            for (auto _ : state) {
+                const auto start = Clock::now();
+                loops.direct->locate(directSpace);
+                const auto middle = Clock::now();
+                loops.layered->locate(layeredSpace);
+                const auto end = Clock::now();
+
+                directNs += ElapsedNs(start, middle);
+                layerNs += ElapsedNs(middle, end);
+            }
+        } catch (std::exception& exc) {
+            state.SkipWithError(exc.what());
+            return;
+        }
+
+        state.counters["DirectNs"] = benchmark::Counter(directNs, benchmark::Counter::kAvgIterations);
+        state.counters["LayerNs"] = benchmark::Counter(layerNs, benchmark::Counter::kAvgIterations);
+        state.counters["OverheadNs"] = benchmark::Counter(layerNs - directNs, benchmark::Counter::kAvgIterations);
+    }
+    BENCHMARK(BM_LocateSpaceOverhead)->ArgName("EyeGaze")->Arg(0)->Arg(1);
+
+} // namespace
@@ -0,0 +1,181 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <mpsc_ring.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // The cost seen by a thread logging a message: formatting it, then either writing and flushing the log file
+    // itself, or handing the record to a background writer. Each benchmark reports the records per second, and the
+    // 99th percentile latency of a call to log as P99EnqueueNs (including two clock reads).
+
+    constexpr size_t RecordLength = 1024;
+
+    struct LogRecord {
+        char text[RecordLength];
+    };
+
+    std::filesystem::path LogPath() {
+        return std::filesystem::temp_directory_path() / "eye-trackers-benchmark.log";
+    }
+
+    // The latency of the most recent calls on one thread, to report the tail next to the throughput.
+    class LatencyRecorder {
+      public:
+        void add(std::chrono::steady_clock::duration latency) {
+            m_latencies[m_count++ % m_latencies.size()] =
+                std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count();
+        }
+
+        // Report the 99th percentile in nanoseconds, averaged over the threads.
+        void report(benchmark::State& state, const char* name) {
+            const auto end = m_latencies.begin() + std::min(m_count, m_latencies.size());
+            const auto p99 = m_latencies.begin() + (end - m_latencies.begin()) * 99 / 100;
+            if (p99 == end) {
+                return;
+            }
+            std::nth_element(m_latencies.begin(), p99, end);
+            state.counters[name] = benchmark::Counter((double)*p99, benchmark::Counter::kAvgThreads);
+        }
+
+      private:
+        std::vector<int64_t> m_latencies = std::vector<int64_t>(1 << 20);
+        size_t m_count{0};
+    };
+
+    void BM_LogSynchronous(benchmark::State& state) {
+        static std::mutex mutex;
+        static std::ofstream logStream;
+        if (state.thread_index() == 0) {
+            logStream.open(LogPath(), std::ios_base::ate);
+        }
+
+        LatencyRecorder latencies;
+        uint64_t i = 0;
+        for (auto _ : state) {
+            const auto start = std::chrono::steady_clock::now();
+            char buf[RecordLength];
+            std::snprintf(
+                buf, sizeof(buf), "Frame %llu: eye gaze sample is %.3f ms old\n", (unsigned long long)i, i * 0.001);
+            i++;
+
+            {
+                std::unique_lock lock(mutex);
+                logStream << buf;
+                logStream.flush();
+            }
+            latencies.add(std::chrono::steady_clock::now() - start);
+        }
+        state.SetItemsProcessed(state.iterations());
+        latencies.report(state, "P99EnqueueNs");
+
+        if (state.thread_index() == 0) {
+            logStream.close();
+        }
+    }
+    BENCHMARK(BM_LogSynchronous)->ThreadRange(1, 4)->UseRealTime();
+
+    class BackgroundWriter {
+      public:
+        BackgroundWriter() : m_logStream(LogPath(), std::ios_base::ate), m_thread([this] { run(); }) {
+        }
+
+        ~BackgroundWriter() {
+            m_running.store(false);
+            m_thread.join();
+        }
+
+        bool log(uint64_t i) {
+            return m_records.tryPush([&](LogRecord& record) {
+                std::snprintf(record.text,
+                              sizeof(record.text),
+                              "Frame %llu: eye gaze sample is %.3f ms old\n",
+                              (unsigned long long)i,
+                              i * 0.001);
+            });
+        }
+
+      private:
+        void run() {
+            while (m_running.load() || m_records.hasPending()) {
+                bool wroteRecords = false;
+                while (m_records.tryPop([&](LogRecord& record) { m_logStream << record.text; })) {
+                    wroteRecords = true;
+                }
+                if (wroteRecords) {
+                    m_logStream.flush();
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        MpscRing<LogRecord, 256> m_records;
+        std::ofstream m_logStream;
+        std::atomic<bool> m_running{true};
+        std::thread m_thread;
+    };
+
+    void BM_LogToRing(benchmark::State& state) {
+        static std::unique_ptr<BackgroundWriter> writer;
+        if (state.thread_index() == 0) {
+            writer = std::make_unique<BackgroundWriter>();
+        }
+
+        LatencyRecorder latencies;
+        uint64_t droppedOnThread = 0;
+        uint64_t i = 0;
+        for (auto _ : state) {
+            const auto start = std::chrono::steady_clock::now();
+            const bool isLogged = writer->log(i++);
+            latencies.add(std::chrono::steady_clock::now() - start);
+            if (!isLogged) {
+                droppedOnThread++;
+            }
+        }
+        // Dropped records are not counted in the throughput. Counters are summed over the threads.
+        state.SetItemsProcessed(state.iterations() - droppedOnThread);
+        state.counters["Dropped"] = (double)droppedOnThread;
+        latencies.report(state, "P99EnqueueNs");
+
+        if (state.thread_index() == 0) {
+            writer.reset();
+        }
+    }
+    BENCHMARK(BM_LogToRing)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
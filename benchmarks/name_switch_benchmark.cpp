@@ -0,0 +1,65 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <name_switch.gen.h>
+
+using namespace openxr_api_layer::name_switch;
+
+namespace {
+
+    // The loader resolves every function through the layer when the instance is created. Each iteration resolves the
+    // whole list once.
+
+    void BM_ResolveAllFunctions(benchmark::State& state) {
+        for (auto _ : state) {
+            for (const char* name : FunctionNames) {
+                benchmark::DoNotOptimize(ResolveHook(name));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * std::size(FunctionNames));
+    }
+    BENCHMARK(BM_ResolveAllFunctions);
+
+    // The lookup the generator emitted before: a string copy of the name compared with each hooked name in turn.
+    void BM_ResolveAllFunctionsByComparison(benchmark::State& state) {
+        for (auto _ : state) {
+            for (const char* name : FunctionNames) {
+                const std::string apiName(name);
+                int hook = -1;
+                for (int i = 0; i < (int)std::size(HookedNames); i++) {
+                    if (apiName == HookedNames[i]) {
+                        hook = i;
+                        break;
+                    }
+                }
+                benchmark::DoNotOptimize(hook);
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * std::size(FunctionNames));
+    }
+    BENCHMARK(BM_ResolveAllFunctionsByComparison);
+
+} // namespace
@@ -0,0 +1,99 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <gaze_trajectory.h>
+#include <prediction.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    constexpr XrDuration SamplePeriod = 5'000'000;
+    constexpr XrDuration PredictionHorizon = 11'000'000;
+
+    // A few seconds of synthetic gaze at 200Hz, with the true gaze one frame after each sample was captured. Blinks
+    // are left out.
+    struct SyntheticSession {
+        std::vector<GazeSample> samples;
+        std::vector<XrVector3f> truths;
+    };
+
+    const SyntheticSession& GetSession() {
+        static const SyntheticSession session = [] {
+            SyntheticSession session;
+            SyntheticGaze gaze(1, 0);
+            for (XrTime time = SamplePeriod; time < 10'000'000'000; time += SamplePeriod) {
+                GazeSample sample;
+                if (gaze.getGazeSample(time, sample)) {
+                    session.samples.push_back(sample);
+                    session.truths.push_back(gaze.getTrueGaze(time + PredictionHorizon));
+                }
+            }
+            return session;
+        }();
+        return session;
+    }
+
+    // The samples keep coming in increasing time as the session loops.
+    GazeSample NextSample(size_t& index) {
+        const auto& samples = GetSession().samples;
+        GazeSample sample = samples[index % samples.size()];
+        sample.time += (XrTime)(index / samples.size()) * (samples.back().time + SamplePeriod);
+        index++;
+        return sample;
+    }
+
+    // Feed a sample and predict one frame ahead, as done on each new sample. The mean error against the true gaze is
+    // reported as ErrorDeg, along with RawErrorDeg without prediction.
+    void BM_Predict(benchmark::State& state) {
+        const auto predictor = state.range(0) ? createKalmanPredictor() : createConstantVelocityPredictor();
+        state.SetLabel(getPredictorType(predictor->getType()));
+        const auto& session = GetSession();
+        size_t index = 0;
+        double error = 0.0, rawError = 0.0;
+        for (auto _ : state) {
+            const size_t truth = index % session.samples.size();
+            const GazeSample sample = NextSample(index);
+            if (truth == 0) {
+                // The session loops with a jump.
+                predictor->reset();
+            }
+            predictor->update(sample);
+            GazePrediction prediction;
+            benchmark::DoNotOptimize(predictor->predict(sample.time + PredictionHorizon, prediction));
+
+            error += std::acos(std::min(gaze::Dot(prediction.unitVector, session.truths[truth]), 1.f));
+            rawError += std::acos(std::min(gaze::Dot(sample.unitVector, session.truths[truth]), 1.f));
+        }
+        state.SetItemsProcessed(state.iterations());
+        state.counters["ErrorDeg"] = error / state.iterations() * 180.0 / 3.14159265;
+        state.counters["RawErrorDeg"] = rawError / state.iterations() * 180.0 / 3.14159265;
+    }
+    BENCHMARK(BM_Predict)->Arg(0)->Arg(1);
+
+} // namespace
@@ -0,0 +1,138 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+#include <benchmark/benchmark.h>
+
+#include <action_spaces.h>
+#include <rcu.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // The action space registry looked up by xrLocateSpace(), with the hands, controllers and eye gaze spaces of a
+    // typical session. Each benchmark looks it up from 1 to 8 threads, to show how readers scale when they contend.
+
+    constexpr uint64_t SpaceCount = 32;
+
+    template <typename Handle = XrSpace>
+    Handle SpaceHandle(uint64_t value) {
+        if constexpr (std::is_pointer_v<Handle>) {
+            return reinterpret_cast<Handle>(static_cast<uintptr_t>(value + 1));
+        } else {
+            return static_cast<Handle>(value + 1);
+        }
+    }
+
+    void AddSpace(ActionsAndSpaces& registry, uint64_t value) {
+        registry.actionSpaces.insert_or_assign(SpaceHandle(value),
+                                               ActionSpace{XrAction{}, {{0.f, 0.f, 0.f, 1.f}, {0.f, 0.f, 0.f}}});
+    }
+
+    ActionsAndSpaces MakeRegistry() {
+        ActionsAndSpaces registry;
+        for (uint64_t i = 0; i < SpaceCount; i++) {
+            AddSpace(registry, i);
+        }
+        return registry;
+    }
+
+    // With a writer, the first thread also destroys and recreates a space every so often, as when an application
+    // creates spaces mid-session.
+    constexpr uint64_t WritePeriod = 256;
+
+    bool IsWrite(const benchmark::State& state, uint64_t value) {
+        return state.range(0) && state.thread_index() == 0 && value % WritePeriod == 0;
+    }
+
+    void RecreateSpace(ActionsAndSpaces& registry, uint64_t value) {
+        registry.actionSpaces.erase(SpaceHandle(value % SpaceCount));
+        AddSpace(registry, value % SpaceCount);
+        registry.updateEyeGazeSpaces();
+    }
+
+    bool Lookup(const ActionsAndSpaces& registry, uint64_t value) {
+        return registry.actionSpaces.find(SpaceHandle(value % SpaceCount)) != registry.actionSpaces.end();
+    }
+
+    // The former registry, under the mutex held by xrLocateSpace().
+    void BM_RegistryMutex(benchmark::State& state) {
+        static std::mutex mutex;
+        static ActionsAndSpaces registry = MakeRegistry();
+        uint64_t value = state.thread_index();
+        for (auto _ : state) {
+            std::unique_lock lock(mutex);
+            if (IsWrite(state, value)) {
+                RecreateSpace(registry, value++);
+            } else {
+                benchmark::DoNotOptimize(Lookup(registry, value++));
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_RegistryMutex)->ArgName("Writer")->Arg(0)->ThreadRange(1, 8)->UseRealTime();
+    BENCHMARK(BM_RegistryMutex)->ArgName("Writer")->Arg(1)->ThreadRange(1, 8)->UseRealTime();
+
+    void BM_RegistrySharedMutex(benchmark::State& state) {
+        static std::shared_mutex mutex;
+        static ActionsAndSpaces registry = MakeRegistry();
+        uint64_t value = state.thread_index();
+        for (auto _ : state) {
+            if (IsWrite(state, value)) {
+                std::unique_lock lock(mutex);
+                RecreateSpace(registry, value++);
+            } else {
+                std::shared_lock lock(mutex);
+                benchmark::DoNotOptimize(Lookup(registry, value++));
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_RegistrySharedMutex)->ArgName("Writer")->Arg(0)->ThreadRange(1, 8)->UseRealTime();
+    BENCHMARK(BM_RegistrySharedMutex)->ArgName("Writer")->Arg(1)->ThreadRange(1, 8)->UseRealTime();
+
+    // The snapshot published by the layer. The writer copies the registry for each update, as xrCreateActionSpace() and
+    // xrDestroySpace() do.
+    void BM_RegistryRcu(benchmark::State& state) {
+        static RcuValue<ActionsAndSpaces> rcu;
+        if (state.thread_index() == 0) {
+            rcu.update([](ActionsAndSpaces& registry) { registry = MakeRegistry(); });
+        }
+        uint64_t value = state.thread_index();
+        for (auto _ : state) {
+            if (IsWrite(state, value)) {
+                rcu.update([&](ActionsAndSpaces& registry) { RecreateSpace(registry, value++); });
+            } else {
+                const auto registry = rcu.read();
+                benchmark::DoNotOptimize(Lookup(*registry, value++));
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_RegistryRcu)->ArgName("Writer")->Arg(0)->ThreadRange(1, 8)->UseRealTime();
+    BENCHMARK(BM_RegistryRcu)->ArgName("Writer")->Arg(1)->ThreadRange(1, 8)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,465 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "runtime_standin.h"
+
+namespace {
+
+    using namespace openxr_api_layer::standin;
+
+    RuntimeOptions g_options;
+    RuntimeStatistics g_statistics;
+
+    std::atomic<uint64_t> g_nextHandle{1};
+
+    std::mutex g_pathsMutex;
+    std::vector<std::string> g_paths;
+    std::unordered_map<std::string, XrPath> g_pathIds;
+
+    template <typename Handle>
+    Handle newHandle() {
+        const uint64_t value = g_nextHandle.fetch_add(1);
+        if constexpr (std::is_pointer_v<Handle>) {
+            return reinterpret_cast<Handle>(value);
+        } else {
+            return (Handle)value;
+        }
+    }
+
+    XrTime now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    // Busy-wait rather than sleep, since the latencies are much shorter than the scheduler's granularity.
+    void spin(std::chrono::nanoseconds duration) {
+        if (duration.count() <= 0) {
+            return;
+        }
+        const auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }
+
+    template <typename Struct>
+    Struct* findInChain(void* next, XrStructureType type) {
+        XrBaseOutStructure* entry = reinterpret_cast<XrBaseOutStructure*>(next);
+        while (entry && entry->type != type) {
+            entry = entry->next;
+        }
+        return reinterpret_cast<Struct*>(entry);
+    }
+
+    XrResult copyString(const std::string& string, uint32_t capacity, uint32_t* count, char* buffer) {
+        *count = (uint32_t)string.size() + 1;
+        if (!capacity) {
+            return XR_SUCCESS;
+        }
+        if (capacity < *count) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        memcpy(buffer, string.c_str(), *count);
+        return XR_SUCCESS;
+    }
+
+    XrPosef identityPose() {
+        XrPosef pose{};
+        pose.orientation.w = 1.f;
+        return pose;
+    }
+
+    XrResult XRAPI_CALL xrDestroyInstance(XrInstance instance) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrEnumerateInstanceExtensionProperties(const char* layerName,
+                                                               uint32_t propertyCapacityInput,
+                                                               uint32_t* propertyCountOutput,
+                                                               XrExtensionProperties* properties) {
+        static const char* const extensions[] = {
+            XR_FB_EYE_TRACKING_SOCIAL_EXTENSION_NAME,
+            XR_KHR_LOCATE_SPACES_EXTENSION_NAME,
+#ifdef _WIN32
+            XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME,
+#endif
+        };
+
+        *propertyCountOutput = (uint32_t)std::size(extensions);
+        if (!propertyCapacityInput) {
+            return XR_SUCCESS;
+        }
+        if (propertyCapacityInput < *propertyCountOutput) {
+            return XR_ERROR_SIZE_INSUFFICIENT;
+        }
+        for (uint32_t i = 0; i < *propertyCountOutput; i++) {
+            strncpy(properties[i].extensionName, extensions[i], XR_MAX_EXTENSION_NAME_SIZE - 1);
+            properties[i].extensionVersion = 1;
+        }
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrGetInstanceProperties(XrInstance instance, XrInstanceProperties* instanceProperties) {
+        instanceProperties->runtimeVersion = XR_MAKE_VERSION(1, 0, 0);
+        strncpy(instanceProperties->runtimeName, "Runtime stand-in", XR_MAX_RUNTIME_NAME_SIZE - 1);
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrPollEvent(XrInstance instance, XrEventDataBuffer* eventData) {
+        return XR_EVENT_UNAVAILABLE;
+    }
+
+    XrResult XRAPI_CALL xrGetSystem(XrInstance instance, const XrSystemGetInfo* getInfo, XrSystemId* systemId) {
+        if (getInfo->formFactor != XR_FORM_FACTOR_HEAD_MOUNTED_DISPLAY) {
+            return XR_ERROR_FORM_FACTOR_UNSUPPORTED;
+        }
+        *systemId = 1;
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrGetSystemProperties(XrInstance instance,
+                                              XrSystemId systemId,
+                                              XrSystemProperties* properties) {
+        properties->systemId = systemId;
+        strncpy(properties->systemName, "Runtime stand-in", XR_MAX_SYSTEM_NAME_SIZE - 1);
+        properties->trackingProperties.orientationTracking = XR_TRUE;
+        properties->trackingProperties.positionTracking = XR_TRUE;
+
+        if (auto eyeTracking = findInChain<XrSystemEyeTrackingPropertiesFB>(
+                properties->next, XR_TYPE_SYSTEM_EYE_TRACKING_PROPERTIES_FB)) {
+            eyeTracking->supportsEyeTracking = XR_TRUE;
+        }
+        // Leave the eye gaze interaction to the layer.
+        if (auto eyeGazeInteraction = findInChain<XrSystemEyeGazeInteractionPropertiesEXT>(
+                properties->next, XR_TYPE_SYSTEM_EYE_GAZE_INTERACTION_PROPERTIES_EXT)) {
+            eyeGazeInteraction->supportsEyeGazeInteraction = XR_FALSE;
+        }
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrCreateSession(XrInstance instance,
+                                        const XrSessionCreateInfo* createInfo,
+                                        XrSession* session) {
+        *session = newHandle<XrSession>();
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrDestroySession(XrSession session) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrBeginSession(XrSession session, const XrSessionBeginInfo* beginInfo) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrEndSession(XrSession session) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrCreateReferenceSpace(XrSession session,
+                                               const XrReferenceSpaceCreateInfo* createInfo,
+                                               XrSpace* space) {
+        *space = newHandle<XrSpace>();
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrCreateActionSpace(XrSession session,
+                                            const XrActionSpaceCreateInfo* createInfo,
+                                            XrSpace* space) {
+        *space = newHandle<XrSpace>();
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrDestroySpace(XrSpace space) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrStringToPath(XrInstance instance, const char* pathString, XrPath* path) {
+        std::unique_lock lock(g_pathsMutex);
+        const auto it = g_pathIds.find(pathString);
+        if (it != g_pathIds.end()) {
+            *path = it->second;
+        } else {
+            g_paths.push_back(pathString);
+            *path = (XrPath)g_paths.size();
+            g_pathIds.insert({pathString, *path});
+        }
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrPathToString(
+        XrInstance instance, XrPath path, uint32_t bufferCapacityInput, uint32_t* bufferCountOutput, char* buffer) {
+        std::unique_lock lock(g_pathsMutex);
+        if (path == XR_NULL_PATH || path > g_paths.size()) {
+            return XR_ERROR_PATH_INVALID;
+        }
+        return copyString(g_paths[path - 1], bufferCapacityInput, bufferCountOutput, buffer);
+    }
+
+    XrResult XRAPI_CALL xrCreateActionSet(XrInstance instance,
+                                          const XrActionSetCreateInfo* createInfo,
+                                          XrActionSet* actionSet) {
+        *actionSet = newHandle<XrActionSet>();
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrDestroyActionSet(XrActionSet actionSet) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrCreateAction(XrActionSet actionSet, const XrActionCreateInfo* createInfo, XrAction* action) {
+        *action = newHandle<XrAction>();
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrDestroyAction(XrAction action) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrSuggestInteractionProfileBindings(
+        XrInstance instance, const XrInteractionProfileSuggestedBinding* suggestedBindings) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrAttachSessionActionSets(XrSession session, const XrSessionActionSetsAttachInfo* attachInfo) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrSyncActions(XrSession session, const XrActionsSyncInfo* syncInfo) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrGetActionStatePose(XrSession session,
+                                             const XrActionStateGetInfo* getInfo,
+                                             XrActionStatePose* state) {
+        state->isActive = XR_TRUE;
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrGetCurrentInteractionProfile(XrSession session,
+                                                       XrPath topLevelUserPath,
+                                                       XrInteractionProfileState* interactionProfile) {
+        interactionProfile->interactionProfile = XR_NULL_PATH;
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrEnumerateBoundSourcesForAction(XrSession session,
+                                                         const XrBoundSourcesForActionEnumerateInfo* enumerateInfo,
+                                                         uint32_t sourceCapacityInput,
+                                                         uint32_t* sourceCountOutput,
+                                                         XrPath* sources) {
+        *sourceCountOutput = 0;
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrGetInputSourceLocalizedName(XrSession session,
+                                                      const XrInputSourceLocalizedNameGetInfo* getInfo,
+                                                      uint32_t bufferCapacityInput,
+                                                      uint32_t* bufferCountOutput,
+                                                      char* buffer) {
+        return copyString("", bufferCapacityInput, bufferCountOutput, buffer);
+    }
+
+    XrResult XRAPI_CALL xrWaitFrame(XrSession session, const XrFrameWaitInfo* frameWaitInfo, XrFrameState* frameState) {
+        spin(g_options.waitFrameLatency);
+        g_statistics.frames++;
+
+        frameState->predictedDisplayPeriod = g_options.displayPeriod;
+        frameState->predictedDisplayTime = now() + 2 * g_options.displayPeriod;
+        frameState->shouldRender = XR_TRUE;
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrBeginFrame(XrSession session, const XrFrameBeginInfo* frameBeginInfo) {
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrEndFrame(XrSession session, const XrFrameEndInfo* frameEndInfo) {
+        return XR_SUCCESS;
+    }
+
+    // Every space is at the origin of every other space, which is all the layer needs to compose the gaze.
+    XrResult XRAPI_CALL xrLocateSpace(XrSpace space, XrSpace baseSpace, XrTime time, XrSpaceLocation* location) {
+        spin(g_options.locateSpaceLatency);
+        g_statistics.locateSpaceCalls++;
+
+        location->locationFlags = XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
+                                  XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+        location->pose = identityPose();
+        if (auto velocity = findInChain<XrSpaceVelocity>(location->next, XR_TYPE_SPACE_VELOCITY)) {
+            velocity->velocityFlags = 0;
+        }
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrLocateSpaces(XrSession session,
+                                       const XrSpacesLocateInfo* locateInfo,
+                                       XrSpaceLocations* spaceLocations) {
+        spin(g_options.locateSpaceLatency);
+        g_statistics.locateSpaceCalls++;
+
+        for (uint32_t i = 0; i < spaceLocations->locationCount; i++) {
+            spaceLocations->locations[i].locationFlags =
+                XR_SPACE_LOCATION_ORIENTATION_VALID_BIT | XR_SPACE_LOCATION_POSITION_VALID_BIT |
+                XR_SPACE_LOCATION_ORIENTATION_TRACKED_BIT | XR_SPACE_LOCATION_POSITION_TRACKED_BIT;
+            spaceLocations->locations[i].pose = identityPose();
+        }
+        if (auto velocities =
+                findInChain<XrSpaceVelocitiesKHR>(spaceLocations->next, XR_TYPE_SPACE_VELOCITIES_KHR)) {
+            for (uint32_t i = 0; i < velocities->velocityCount; i++) {
+                velocities->velocities[i].velocityFlags = 0;
+            }
+        }
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrCreateEyeTrackerFB(XrSession session,
+                                             const XrEyeTrackerCreateInfoFB* createInfo,
+                                             XrEyeTrackerFB* eyeTracker) {
+        *eyeTracker = newHandle<XrEyeTrackerFB>();
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrDestroyEyeTrackerFB(XrEyeTrackerFB eyeTracker) {
+        return XR_SUCCESS;
+    }
+
+    // The eyes sweep left and right, so that the layer always has motion to filter or predict.
+    XrResult XRAPI_CALL xrGetEyeGazesFB(XrEyeTrackerFB eyeTracker,
+                                        const XrEyeGazesInfoFB* gazeInfo,
+                                        XrEyeGazesFB* eyeGazes) {
+        spin(g_options.eyeGazesLatency);
+        g_statistics.eyeGazesCalls++;
+
+        eyeGazes->time = gazeInfo->time - g_options.eyeGazeAge;
+        const float yaw = 0.3f * std::sin(eyeGazes->time / 1e9f);
+        for (XrEyeGazeFB& gaze : eyeGazes->gaze) {
+            gaze.isValid = XR_TRUE;
+            gaze.gazeConfidence = 1.f;
+            gaze.gazePose = identityPose();
+            gaze.gazePose.orientation.y = std::sin(yaw / 2);
+            gaze.gazePose.orientation.w = std::cos(yaw / 2);
+        }
+        return XR_SUCCESS;
+    }
+
+#ifdef _WIN32
+    XrResult XRAPI_CALL xrConvertWin32PerformanceCounterToTimeKHR(XrInstance instance,
+                                                                  const LARGE_INTEGER* performanceCounter,
+                                                                  XrTime* time) {
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        *time = (XrTime)(performanceCounter->QuadPart * (1e9 / frequency.QuadPart));
+        return XR_SUCCESS;
+    }
+#endif
+
+} // namespace
+
+namespace openxr_api_layer::standin {
+
+    void SetRuntimeOptions(const RuntimeOptions& options) {
+        g_options = options;
+    }
+
+    RuntimeStatistics& GetRuntimeStatistics() {
+        return g_statistics;
+    }
+
+    XrResult XRAPI_CALL xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function) {
+#define STANDIN_FUNCTION(name) {#name, reinterpret_cast<PFN_xrVoidFunction>(::name)}
+#define STANDIN_ALIAS(name, implementation) {#name, reinterpret_cast<PFN_xrVoidFunction>(::implementation)}
+        static const std::unordered_map<std::string_view, PFN_xrVoidFunction> functions = {
+            {"xrGetInstanceProcAddr", reinterpret_cast<PFN_xrVoidFunction>(standin::xrGetInstanceProcAddr)},
+            STANDIN_FUNCTION(xrDestroyInstance),
+            STANDIN_FUNCTION(xrEnumerateInstanceExtensionProperties),
+            STANDIN_FUNCTION(xrGetInstanceProperties),
+            STANDIN_FUNCTION(xrPollEvent),
+            STANDIN_FUNCTION(xrGetSystem),
+            STANDIN_FUNCTION(xrGetSystemProperties),
+            STANDIN_FUNCTION(xrCreateSession),
+            STANDIN_FUNCTION(xrDestroySession),
+            STANDIN_FUNCTION(xrBeginSession),
+            STANDIN_FUNCTION(xrEndSession),
+            STANDIN_FUNCTION(xrCreateReferenceSpace),
+            STANDIN_FUNCTION(xrCreateActionSpace),
+            STANDIN_FUNCTION(xrDestroySpace),
+            STANDIN_FUNCTION(xrStringToPath),
+            STANDIN_FUNCTION(xrPathToString),
+            STANDIN_FUNCTION(xrCreateActionSet),
+            STANDIN_FUNCTION(xrDestroyActionSet),
+            STANDIN_FUNCTION(xrCreateAction),
+            STANDIN_FUNCTION(xrDestroyAction),
+            STANDIN_FUNCTION(xrSuggestInteractionProfileBindings),
+            STANDIN_FUNCTION(xrAttachSessionActionSets),
+            STANDIN_FUNCTION(xrSyncActions),
+            STANDIN_FUNCTION(xrGetActionStatePose),
+            STANDIN_FUNCTION(xrGetCurrentInteractionProfile),
+            STANDIN_FUNCTION(xrEnumerateBoundSourcesForAction),
+            STANDIN_FUNCTION(xrGetInputSourceLocalizedName),
+            STANDIN_FUNCTION(xrWaitFrame),
+            STANDIN_FUNCTION(xrBeginFrame),
+            STANDIN_FUNCTION(xrEndFrame),
+            STANDIN_FUNCTION(xrLocateSpace),
+            STANDIN_FUNCTION(xrLocateSpaces),
+            STANDIN_ALIAS(xrLocateSpacesKHR, xrLocateSpaces),
+            STANDIN_FUNCTION(xrCreateEyeTrackerFB),
+            STANDIN_FUNCTION(xrDestroyEyeTrackerFB),
+            STANDIN_FUNCTION(xrGetEyeGazesFB),
+#ifdef _WIN32
+            STANDIN_FUNCTION(xrConvertWin32PerformanceCounterToTimeKHR),
+#endif
+        };
+#undef STANDIN_FUNCTION
+#undef STANDIN_ALIAS
+
+        const auto it = functions.find(name);
+        if (it == functions.end()) {
+            *function = nullptr;
+            return XR_ERROR_FUNCTION_UNSUPPORTED;
+        }
+        *function = it->second;
+        return XR_SUCCESS;
+    }
+
+    XrResult XRAPI_CALL xrCreateApiLayerInstance(const XrInstanceCreateInfo* createInfo,
+                                                 const XrApiLayerCreateInfo* apiLayerInfo,
+                                                 XrInstance* instance) {
+        // The stand-in is the end of the chain.
+        if (!createInfo || (apiLayerInfo && apiLayerInfo->nextInfo)) {
+            return XR_ERROR_INITIALIZATION_FAILED;
+        }
+
+        *instance = newHandle<XrInstance>();
+        return XR_SUCCESS;
+    }
+
+} // namespace openxr_api_layer::standin
@@ -0,0 +1,76 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#define XR_USE_PLATFORM_WIN32
+#endif
+
+#define XR_NO_PROTOTYPES
+#include <openxr/openxr.h>
+#include <openxr/openxr_platform.h>
+
+#include <loader_interfaces.h>
+
+// An in-process stand-in for the OpenXR runtime, to place behind the layer instead of a real runtime and headset. It
+// implements the functions the layer requests (see layer_apis.py) and the ones a frame loop calls, with configurable
+// latencies. It reports eye tracking through XR_FB_eye_tracking_social, which the layer picks up like on a Quest Pro.
+namespace openxr_api_layer::standin {
+
+    struct RuntimeOptions {
+        // Time spent in each call, to stand in for the work of a real runtime.
+        std::chrono::nanoseconds waitFrameLatency{0};
+        std::chrono::nanoseconds locateSpaceLatency{0};
+        std::chrono::nanoseconds eyeGazesLatency{0};
+
+        XrDuration displayPeriod{11'111'111};
+
+        // How long before the requested time the eye gaze was captured.
+        XrDuration eyeGazeAge{5'000'000};
+    };
+
+    // Takes effect on the next call. Must not be changed while a frame is running.
+    void SetRuntimeOptions(const RuntimeOptions& options);
+
+    struct RuntimeStatistics {
+        std::atomic<uint64_t> locateSpaceCalls{0};
+        std::atomic<uint64_t> eyeGazesCalls{0};
+        std::atomic<uint64_t> frames{0};
+    };
+
+    RuntimeStatistics& GetRuntimeStatistics();
+
+    // The entry points to give to the layer in XrApiLayerNextInfo, or to call directly as a runtime without layers.
+    XrResult XRAPI_CALL xrGetInstanceProcAddr(XrInstance instance, const char* name, PFN_xrVoidFunction* function);
+    XrResult XRAPI_CALL xrCreateApiLayerInstance(const XrInstanceCreateInfo* createInfo,
+                                                 const XrApiLayerCreateInfo* apiLayerInfo,
+                                                 XrInstance* instance);
+
+} // namespace openxr_api_layer::standin
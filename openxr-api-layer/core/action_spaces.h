@@ -0,0 +1,70 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "xr_types.h"
+
+namespace openxr_api_layer {
+
+    struct ActionSpace {
+        XrAction action;
+        XrPosef pose;
+    };
+
+    // The actions bound to the eye gaze interaction profile, and the action spaces created by the application. It is
+    // rebuilt whenever actions are bound or action spaces are created and destroyed, which is rare, while it is looked
+    // up for every space location.
+    struct ActionsAndSpaces {
+        std::unordered_set<XrAction> eyeGazeActions;
+        std::unordered_map<XrSpace, ActionSpace> actionSpaces;
+
+        // The spaces of eye gaze actions, kept apart so that locating any other space only scans this (typically tiny)
+        // array.
+        std::vector<std::pair<XrSpace, XrPosef>> eyeGazeSpaces;
+
+        void updateEyeGazeSpaces() {
+            eyeGazeSpaces.clear();
+            for (const auto& [space, actionSpace] : actionSpaces) {
+                if (eyeGazeActions.count(actionSpace.action)) {
+                    eyeGazeSpaces.push_back({space, actionSpace.pose});
+                }
+            }
+        }
+
+        bool findEyeGazeSpace(XrSpace space, XrPosef& pose) const {
+            for (const auto& [eyeGazeSpace, eyeGazePose] : eyeGazeSpaces) {
+                if (eyeGazeSpace == space) {
+                    pose = eyeGazePose;
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+} // namespace openxr_api_layer
@@ -0,0 +1,155 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+
+#include <seqlock.h>
+
+namespace openxr_api_layer {
+
+    // Tracks the relationship between a local clock and a remote clock (both in nanoseconds), as a line fitted through
+    // pairs of readings of both clocks. The fit follows both the offset and the drift between the clocks.
+    //
+    // Samples may be added from any thread (concurrent samples are dropped), and conversions are lock-free and O(1).
+    class ClockCorrelation {
+      public:
+        // Samples are taken frequently until the window is full, then at a slower pace to follow the drift.
+        static constexpr size_t WindowSize = 16;
+        static constexpr int64_t FastSamplingPeriod = 100'000'000;
+        static constexpr int64_t SlowSamplingPeriod = 1'000'000'000;
+
+        // Two clocks drifting more than this apart (parts per million) indicates a bad fit rather than real drift.
+        static constexpr double MaxDrift = 1000e-6;
+
+        // Whether a new sample should be added at the given local time.
+        bool needsSample(int64_t local) const {
+            return local >= m_nextSampleTime.load(std::memory_order_relaxed);
+        }
+
+        // Record that the remote clock read `remote` while the local clock was between `localBefore` and
+        // `localAfter`.
+        void addSample(int64_t localBefore, int64_t remote, int64_t localAfter) {
+            std::unique_lock lock(m_sampleMutex, std::try_to_lock);
+            if (!lock) {
+                return;
+            }
+
+            Sample& sample = m_window[m_sampleCount++ % WindowSize];
+            sample.local = localBefore + (localAfter - localBefore) / 2;
+            sample.remote = remote;
+            sample.uncertainty = (double)std::max(localAfter - localBefore, (int64_t)0) / 2.0;
+
+            fit();
+
+            m_nextSampleTime.store(localAfter + (m_sampleCount < WindowSize ? FastSamplingPeriod : SlowSamplingPeriod),
+                                   std::memory_order_relaxed);
+        }
+
+        void reset() {
+            std::unique_lock lock(m_sampleMutex);
+            m_sampleCount = 0;
+            m_nextSampleTime.store(INT64_MIN, std::memory_order_relaxed);
+            m_fit.store({});
+        }
+
+        bool isValid() const {
+            return m_fit.load().isValid;
+        }
+
+        int64_t toRemote(int64_t local) const {
+            const Fit fit = m_fit.load();
+            return fit.remote + (int64_t)std::llround((double)(local - fit.local) * fit.slope);
+        }
+
+        int64_t toLocal(int64_t remote) const {
+            const Fit fit = m_fit.load();
+            return fit.local + (int64_t)std::llround((double)(remote - fit.remote) / fit.slope);
+        }
+
+      private:
+        struct Sample {
+            int64_t local;
+            int64_t remote;
+            double uncertainty;
+        };
+
+        struct Fit {
+            int64_t local{0};
+            int64_t remote{0};
+            double slope{1.0};
+            bool isValid{false};
+        };
+
+        // Weighted least squares through the samples in the window. Readings with a tighter bracket weigh more.
+        void fit() {
+            const size_t count = std::min(m_sampleCount, WindowSize);
+            const Sample& reference = m_window[(m_sampleCount - 1) % WindowSize];
+
+            double sumW = 0, sumX = 0, sumY = 0;
+            for (size_t i = 0; i < count; i++) {
+                const double w = weight(m_window[i]);
+                sumW += w;
+                sumX += w * (double)(m_window[i].local - reference.local);
+                sumY += w * (double)(m_window[i].remote - reference.remote);
+            }
+            const double meanX = sumX / sumW;
+            const double meanY = sumY / sumW;
+
+            double sxx = 0, sxy = 0;
+            for (size_t i = 0; i < count; i++) {
+                const double w = weight(m_window[i]);
+                const double dx = (double)(m_window[i].local - reference.local) - meanX;
+                const double dy = (double)(m_window[i].remote - reference.remote) - meanY;
+                sxx += w * dx * dx;
+                sxy += w * dx * dy;
+            }
+
+            Fit fit;
+            fit.local = reference.local + (int64_t)std::llround(meanX);
+            fit.remote = reference.remote + (int64_t)std::llround(meanY);
+            // We need the samples to span a few milliseconds before we can tell the drift.
+            fit.slope = (count > 1 && sxx / sumW > 1e12) ? std::clamp(sxy / sxx, 1.0 - MaxDrift, 1.0 + MaxDrift) : 1.0;
+            fit.isValid = true;
+            m_fit.store(fit);
+        }
+
+        static double weight(const Sample& sample) {
+            // Floor at 1us to not overweigh a single lucky reading.
+            const double uncertainty = std::max(sample.uncertainty, 1000.0);
+            return 1.0 / (uncertainty * uncertainty);
+        }
+
+        std::mutex m_sampleMutex;
+        Sample m_window[WindowSize]{};
+        size_t m_sampleCount{0};
+        std::atomic<int64_t> m_nextSampleTime{INT64_MIN};
+
+        SeqLock<Fit> m_fit;
+    };
+
+} // namespace openxr_api_layer
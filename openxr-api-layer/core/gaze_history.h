@@ -0,0 +1,144 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <seqlock.h>
+
+#include "gaze_math.h"
+
+namespace openxr_api_layer {
+
+    // A gaze sample, as captured by an eye tracker.
+    struct GazeSample {
+        // The time the sample was captured, in the XrTime domain.
+        XrTime time{0};
+
+        // The gaze direction of each eye, as unit vectors in view space.
+        XrVector3f eyeUnitVector[EyeCount]{};
+
+        // The combined gaze direction, as a unit vector in view space.
+        XrVector3f unitVector{};
+
+        // The combined gaze orientation in view space, looking down -Z. Trackers that report a pose keep its roll.
+        XrQuaternionf orientation{0.f, 0.f, 0.f, 1.f};
+
+        bool isValid{false};
+    };
+
+    namespace gaze {
+
+        // Interpolate between two samples. Both samples must be valid.
+        static inline GazeSample Interpolate(const GazeSample& older, const GazeSample& newer, XrTime time) {
+            const float alpha =
+                newer.time > older.time ? (float)(time - older.time) / (float)(newer.time - older.time) : 1.f;
+
+            GazeSample result;
+            result.time = time;
+            for (uint32_t eye = 0; eye < EyeCount; eye++) {
+                result.eyeUnitVector[eye] = Nlerp(older.eyeUnitVector[eye], newer.eyeUnitVector[eye], alpha);
+            }
+            result.unitVector = Nlerp(older.unitVector, newer.unitVector, alpha);
+            result.orientation = Slerp(older.orientation, newer.orientation, alpha);
+            result.isValid = true;
+            return result;
+        }
+
+    } // namespace gaze
+
+    // A fixed-capacity history of gaze samples. There must be a single producer thread, but any number of threads can
+    // query the history without locking.
+    template <size_t Capacity = 64>
+    class GazeHistory {
+        static_assert(Capacity >= 4 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+      public:
+        // Append a sample. Samples must be pushed in increasing time order.
+        void push(const GazeSample& sample) {
+            const uint64_t index = m_head.load(std::memory_order_relaxed);
+            m_slots[index & (Capacity - 1)].store(sample);
+            m_head.store(index + 1, std::memory_order_release);
+        }
+
+        void clear() {
+            // The slots will be overwritten, only the head needs to be reset. Only the producer may call this.
+            m_head.store(0, std::memory_order_release);
+        }
+
+        // Retrieve the most recent sample.
+        bool latest(GazeSample& sample) const {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            return head && m_slots[(head - 1) & (Capacity - 1)].tryLoad(sample);
+        }
+
+        // Retrieve the gaze at the requested time, by interpolating between the two samples bracketing that time. Times
+        // outside of the history are clamped to the oldest or the most recent sample.
+        bool sample(XrTime time, GazeSample& result) const {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            if (!head) {
+                return false;
+            }
+
+            GazeSample newer;
+            if (!m_slots[(head - 1) & (Capacity - 1)].tryLoad(newer)) {
+                return false;
+            }
+            if (time >= newer.time) {
+                result = newer;
+                return true;
+            }
+
+            // Walk back the history. We leave one slot to the producer, so it cannot be torn while we walk.
+            const uint64_t oldest = head > Capacity - 1 ? head - (Capacity - 1) : 0;
+            for (uint64_t index = head - 1; index > oldest; index--) {
+                GazeSample older;
+                // A sample that is torn or more recent than its successor means the producer wrapped around.
+                if (!m_slots[(index - 1) & (Capacity - 1)].tryLoad(older) || older.time >= newer.time) {
+                    break;
+                }
+
+                if (older.time <= time) {
+                    if (older.isValid && newer.isValid) {
+                        result = gaze::Interpolate(older, newer, time);
+                    } else {
+                        result = (time - older.time) < (newer.time - time) ? older : newer;
+                    }
+                    return true;
+                }
+
+                newer = older;
+            }
+
+            result = newer;
+            return true;
+        }
+
+      private:
+        std::atomic<uint64_t> m_head{0};
+        SeqLock<GazeSample> m_slots[Capacity];
+    };
+
+} // namespace openxr_api_layer
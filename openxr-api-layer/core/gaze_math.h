@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+
+#include "xr_types.h"
+
+namespace openxr_api_layer::gaze {
+
+    // Plain scalar vector and quaternion math, so that the gaze pipeline does not depend on DirectXMath. Quaternions
+    // follow the DirectXMath conventions.
+
+    static inline float Dot(const XrVector3f& a, const XrVector3f& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    static inline XrVector3f Cross(const XrVector3f& a, const XrVector3f& b) {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+
+    static inline XrVector3f Normalize(const XrVector3f& v) {
+        const float length = std::sqrt(Dot(v, v));
+        if (length < FLT_EPSILON) {
+            return v;
+        }
+        return {v.x / length, v.y / length, v.z / length};
+    }
+
+    static inline XrQuaternionf Normalize(const XrQuaternionf& q) {
+        const float length = std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if (length < FLT_EPSILON) {
+            return {0.f, 0.f, 0.f, 1.f};
+        }
+        return {q.x / length, q.y / length, q.z / length, q.w / length};
+    }
+
+    static inline XrVector3f Nlerp(const XrVector3f& a, const XrVector3f& b, float alpha) {
+        const XrVector3f v{a.x + (b.x - a.x) * alpha, a.y + (b.y - a.y) * alpha, a.z + (b.z - a.z) * alpha};
+        const float length = std::sqrt(Dot(v, v));
+        if (length < FLT_EPSILON) {
+            return alpha < 0.5f ? a : b;
+        }
+        return {v.x / length, v.y / length, v.z / length};
+    }
+
+    // The rotation `a` followed by the rotation `b`, like XMQuaternionMultiply().
+    static inline XrQuaternionf Multiply(const XrQuaternionf& a, const XrQuaternionf& b) {
+        return {b.w * a.x + b.x * a.w + b.y * a.z - b.z * a.y,
+                b.w * a.y - b.x * a.z + b.y * a.w + b.z * a.x,
+                b.w * a.z + b.x * a.y - b.y * a.x + b.z * a.w,
+                b.w * a.w - b.x * a.x - b.y * a.y - b.z * a.z};
+    }
+
+    static inline XrVector3f Rotate(const XrVector3f& v, const XrQuaternionf& q) {
+        const XrVector3f u{q.x, q.y, q.z};
+        const XrVector3f t = Cross(u, v);
+        const XrVector3f t2{2.f * t.x, 2.f * t.y, 2.f * t.z};
+        const XrVector3f c = Cross(u, t2);
+        return {v.x + q.w * t2.x + c.x, v.y + q.w * t2.y + c.y, v.z + q.w * t2.z + c.z};
+    }
+
+    static inline XrVector3f InverseRotate(const XrVector3f& v, const XrQuaternionf& q) {
+        return Rotate(v, {-q.x, -q.y, -q.z, q.w});
+    }
+
+    // The shortest rotation taking the unit vector `from` onto the unit vector `to`.
+    static inline XrQuaternionf RotationBetween(const XrVector3f& from, const XrVector3f& to) {
+        // The quaternion (from x to, 1 + from . to) is twice the rotation, normalizing it yields the half-angle.
+        const float w = 1.f + Dot(from, to);
+        if (w < 1e-6f) {
+            // Opposite vectors: any half-turn about an axis perpendicular to `from` will do.
+            XrVector3f axis = Cross(from, {1.f, 0.f, 0.f});
+            if (Dot(axis, axis) < 1e-6f) {
+                axis = Cross(from, {0.f, 1.f, 0.f});
+            }
+            axis = Normalize(axis);
+            return {axis.x, axis.y, axis.z, 0.f};
+        }
+        const XrVector3f axis = Cross(from, to);
+        return Normalize(XrQuaternionf{axis.x, axis.y, axis.z, w});
+    }
+
+    // The orientation looking down the gaze direction.
+    static inline XrQuaternionf OrientationFromUnitVector(const XrVector3f& unitVector) {
+        return RotationBetween({0.f, 0.f, -1.f}, Normalize(unitVector));
+    }
+
+    // Spherical interpolation along the shortest path, like XMQuaternionSlerp().
+    static inline XrQuaternionf Slerp(const XrQuaternionf& a, const XrQuaternionf& b, float alpha) {
+        float cosOmega = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        const float sign = cosOmega < 0.f ? -1.f : 1.f;
+        cosOmega *= sign;
+
+        float scaleA = 1.f - alpha;
+        float scaleB = alpha;
+        // Close orientations interpolate linearly, to not divide by a vanishing sine.
+        if (cosOmega < 1.f - 1e-6f) {
+            const float omega = std::acos(cosOmega);
+            const float sinOmega = std::sin(omega);
+            scaleA = std::sin(scaleA * omega) / sinOmega;
+            scaleB = std::sin(scaleB * omega) / sinOmega;
+        }
+        scaleB *= sign;
+
+        return Normalize(XrQuaternionf{scaleA * a.x + scaleB * b.x,
+                                       scaleA * a.y + scaleB * b.y,
+                                       scaleA * a.z + scaleB * b.z,
+                                       scaleA * a.w + scaleB * b.w});
+    }
+
+} // namespace openxr_api_layer::gaze
@@ -0,0 +1,154 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#include "gaze_recording_format.h"
+
+namespace openxr_api_layer {
+
+    using namespace recording;
+
+    namespace {
+
+        uint64_t ZigZag(int64_t value) {
+            return ((uint64_t)value << 1) ^ (uint64_t)(value >> 63);
+        }
+
+        int64_t UnZigZag(uint64_t value) {
+            return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+        }
+
+        uint8_t* WriteVarint(uint8_t* out, uint64_t value) {
+            while (value >= 0x80) {
+                *out++ = (uint8_t)(value | 0x80);
+                value >>= 7;
+            }
+            *out++ = (uint8_t)value;
+            return out;
+        }
+
+        bool ReadVarint(const uint8_t*& in, const uint8_t* end, uint64_t& value) {
+            value = 0;
+            for (uint32_t shift = 0; in < end && shift < 64; shift += 7) {
+                const uint8_t byte = *in++;
+                value |= (uint64_t)(byte & 0x7f) << shift;
+                if (byte < 0x80) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        uint8_t* WriteUnitVector(uint8_t* out, const XrVector3f& unitVector) {
+            const int16_t quantized[3] = {(int16_t)std::lround(std::clamp(unitVector.x, -1.f, 1.f) * 32767.f),
+                                          (int16_t)std::lround(std::clamp(unitVector.y, -1.f, 1.f) * 32767.f),
+                                          (int16_t)std::lround(std::clamp(unitVector.z, -1.f, 1.f) * 32767.f)};
+            memcpy(out, quantized, sizeof(quantized));
+            return out + sizeof(quantized);
+        }
+
+        XrVector3f ReadUnitVector(const uint8_t*& in) {
+            int16_t quantized[3];
+            memcpy(quantized, in, sizeof(quantized));
+            in += sizeof(quantized);
+            return gaze::Normalize(XrVector3f{quantized[0] / 32767.f, quantized[1] / 32767.f, quantized[2] / 32767.f});
+        }
+
+    } // namespace
+
+    namespace recording {
+
+        uint8_t* WriteRecord(
+            uint8_t* out, XrTime previousQueryTime, XrTime queryTime, bool isValid, const GazeSample& sample) {
+            out = WriteVarint(out, ZigZag(queryTime - previousQueryTime));
+            *out++ = isValid ? IsValid : 0;
+            if (isValid) {
+                out = WriteVarint(out, ZigZag(queryTime - sample.time));
+                out = WriteUnitVector(out, sample.unitVector);
+                out = WriteUnitVector(out, sample.eyeUnitVector[0]);
+                out = WriteUnitVector(out, sample.eyeUnitVector[1]);
+            }
+            return out;
+        }
+
+    } // namespace recording
+
+    bool ParseRecording(const uint8_t* data,
+                        size_t size,
+                        std::vector<RecordedGaze>& records,
+                        std::string& trackerName) {
+        FileHeader header;
+        if (size < sizeof(header)) {
+            return false;
+        }
+        memcpy(&header, data, sizeof(header));
+        if (memcmp(header.magic, Magic, sizeof(Magic)) || header.version != Version || header.chunkSize != ChunkSize) {
+            return false;
+        }
+        header.trackerName[sizeof(header.trackerName) - 1] = '\0';
+        trackerName = header.trackerName;
+
+        records.clear();
+        for (size_t chunk = ChunkSize; chunk + sizeof(ChunkHeader) <= size; chunk += ChunkSize) {
+            ChunkHeader chunkHeader;
+            memcpy(&chunkHeader, data + chunk, sizeof(chunkHeader));
+            if (chunkHeader.usedBytes < sizeof(ChunkHeader) || chunkHeader.usedBytes > ChunkSize ||
+                chunk + chunkHeader.usedBytes > size) {
+                return false;
+            }
+
+            const uint8_t* in = data + chunk + sizeof(ChunkHeader);
+            const uint8_t* const end = data + chunk + chunkHeader.usedBytes;
+            XrTime queryTime = chunkHeader.baseTime;
+            for (uint32_t i = 0; i < chunkHeader.recordCount; i++) {
+                RecordedGaze record;
+                uint64_t delta;
+                if (!ReadVarint(in, end, delta) || in == end) {
+                    return false;
+                }
+                queryTime += UnZigZag(delta);
+                record.queryTime = queryTime;
+                record.isValid = *in++ & IsValid;
+                if (record.isValid) {
+                    uint64_t age;
+                    if (!ReadVarint(in, end, age) || end - in < 9 * (ptrdiff_t)sizeof(int16_t)) {
+                        return false;
+                    }
+                    record.sample.time = queryTime - UnZigZag(age);
+                    record.sample.unitVector = ReadUnitVector(in);
+                    record.sample.eyeUnitVector[0] = ReadUnitVector(in);
+                    record.sample.eyeUnitVector[1] = ReadUnitVector(in);
+                    record.sample.orientation = gaze::OrientationFromUnitVector(record.sample.unitVector);
+                    record.sample.isValid = true;
+                }
+                records.push_back(record);
+            }
+        }
+
+        return true;
+    }
+
+} // namespace openxr_api_layer
@@ -0,0 +1,95 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gaze_history.h"
+
+namespace openxr_api_layer {
+
+    // Gaze recordings are append-only files made of a FileHeader followed by fixed-size chunks. Each chunk starts with
+    // a ChunkHeader, followed by variable-length records. Times are delta-encoded within a chunk, so that each chunk
+    // can be decoded on its own. A record is:
+    //
+    //   varint  zigzag(queryTime - previous queryTime), with the chunk's baseTime preceding the first record
+    //   uint8   flags (RecordFlags)
+    //
+    // followed, only when IsValid is set, by:
+    //
+    //   varint  zigzag(queryTime - sample time)
+    //   int16   combined, left and right unit vectors (x, y, z), scaled by 32767
+    //
+    // The recorder writes them (gaze_recording.h), and ParseRecording() and scripts/gaze_recording.py read them.
+    namespace recording {
+
+        constexpr char Magic[8] = {'X', 'R', 'G', 'A', 'Z', 'E', '\0', '\0'};
+        constexpr uint32_t Version = 2;
+        // A multiple of the allocation granularity, so that chunks can be mapped on their own.
+        constexpr uint32_t ChunkSize = 64 * 1024;
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t chunkSize;
+            // The name from getTrackerType(), null-terminated, since the values of TrackerType differ between the
+            // 32-bit and 64-bit builds.
+            char trackerName[32];
+        };
+
+        struct ChunkHeader {
+            uint32_t recordCount;
+            // Including the chunk header.
+            uint32_t usedBytes;
+            XrTime baseTime;
+        };
+
+        enum RecordFlags : uint8_t {
+            IsValid = 1 << 0,
+        };
+
+        // Two 64-bit varints, the flags and 3 quantized vectors.
+        constexpr uint32_t MaxRecordSize = 2 * 10 + 1 + 9 * sizeof(int16_t);
+
+        // Encode a record at out, which must have room for MaxRecordSize bytes. The sample is only read when valid.
+        // Returns the end of the record.
+        uint8_t* WriteRecord(
+            uint8_t* out, XrTime previousQueryTime, XrTime queryTime, bool isValid, const GazeSample& sample);
+
+    } // namespace recording
+
+    struct RecordedGaze {
+        XrTime queryTime{0};
+        bool isValid{false};
+        GazeSample sample;
+    };
+
+    // Decode a whole recording held in memory. Returns false if it is not a valid recording.
+    bool ParseRecording(const uint8_t* data,
+                        size_t size,
+                        std::vector<RecordedGaze>& records,
+                        std::string& trackerName);
+
+} // namespace openxr_api_layer
@@ -0,0 +1,92 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "gaze_recording_format.h"
+
+namespace openxr_api_layer {
+
+    // Play back a gaze recording. In real time, the recording is laid out from the first query, and each query returns
+    // the sample that had been recorded at the same point. Otherwise, each query returns the next sample, for runs that
+    // should not depend on timing. In both cases, the samples keep their recorded age, and the recording is looped.
+    // The recording must not be empty.
+    class GazeReplay {
+      public:
+        GazeReplay(std::vector<RecordedGaze> records, bool isRealTime)
+            : m_records(std::move(records)), m_isRealTime(isRealTime),
+              m_duration(m_records.back().queryTime - m_records.front().queryTime + 1) {
+        }
+
+        void restart() {
+            m_next = 0;
+            m_startTime = 0;
+        }
+
+        // Returns false when the recorded query had no valid sample.
+        bool getGazeSample(XrTime time, GazeSample& sample) {
+            const RecordedGaze* record;
+            XrTime recordedTime;
+            if (m_isRealTime) {
+                if (!m_startTime) {
+                    m_startTime = time;
+                }
+                recordedTime = m_records.front().queryTime + std::max(time - m_startTime, (XrTime)0) % m_duration;
+
+                // Queries are mostly in increasing time, so we only search from the beginning when the recording loops
+                // or when an earlier time is requested.
+                if (recordedTime < m_records[m_next].queryTime) {
+                    m_next = 0;
+                }
+                while (m_next + 1 < m_records.size() && m_records[m_next + 1].queryTime <= recordedTime) {
+                    m_next++;
+                }
+                record = &m_records[m_next];
+            } else {
+                record = &m_records[m_next];
+                recordedTime = record->queryTime;
+                m_next = (m_next + 1) % m_records.size();
+            }
+
+            if (!record->isValid) {
+                return false;
+            }
+
+            sample = record->sample;
+            sample.time = record->sample.time + (time - recordedTime);
+
+            return true;
+        }
+
+      private:
+        const std::vector<RecordedGaze> m_records;
+        const bool m_isRealTime;
+        const XrDuration m_duration;
+
+        size_t m_next{0};
+        XrTime m_startTime{0};
+    };
+
+} // namespace openxr_api_layer
@@ -0,0 +1,195 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "gaze_trajectory.h"
+
+namespace openxr_api_layer {
+
+    using namespace synthetic;
+
+    namespace {
+
+        constexpr float Pi = 3.14159265358979f;
+        constexpr float DegreesToRadians = Pi / 180.f;
+
+        // Keep the gaze within a comfortable field of view (radians).
+        constexpr float MaxYaw = 25.f * DegreesToRadians;
+        constexpr float MaxPitch = 20.f * DegreesToRadians;
+
+        // Standard deviation of the measurement noise of each eye (radians).
+        constexpr float MeasurementNoise = 0.3f * DegreesToRadians;
+
+        // How many movements of the trajectory we remember, for queries back in time.
+        constexpr size_t MaxMovements = 1024;
+
+        // Standard normal noise, as a function of the seed and time only.
+        float Noise(uint64_t seed, XrTime time, uint64_t stream) {
+            SplitMix64 random(SplitMix64::Mix(seed ^ SplitMix64::Mix((uint64_t)time * 4 + stream)));
+            const float u1 = std::max(random.uniform(0.f, 1.f), FLT_MIN);
+            const float u2 = random.uniform(0.f, 1.f);
+            return std::sqrt(-2.f * std::log(u1)) * std::cos(2.f * Pi * u2);
+        }
+
+    } // namespace
+
+    namespace synthetic {
+
+        XrVector3f FromAngles(const GazeAngles& angles) {
+            return {std::sin(angles.yaw) * std::cos(angles.pitch),
+                    std::sin(angles.pitch),
+                    -std::cos(angles.yaw) * std::cos(angles.pitch)};
+        }
+
+        GazeTrajectory::GazeTrajectory(uint64_t seed) : m_random(seed) {
+            m_movements.push_back({MovementType::Fixation, 0, 300'000'000, {}, {}});
+        }
+
+        bool GazeTrajectory::evaluate(XrDuration time, GazeAngles& angles) {
+            const Movement& movement = findMovement(time);
+
+            const float t =
+                std::clamp((float)(time - movement.start) / (float)(movement.end - movement.start), 0.f, 1.f);
+            float progress = t;
+            if (movement.type == MovementType::Saccade) {
+                // Minimum-jerk profile: a bell-shaped velocity, peaking at 1.875 times the mean velocity.
+                progress = t * t * t * (10.f + t * (-15.f + t * 6.f));
+            }
+            angles.yaw = movement.from.yaw + (movement.to.yaw - movement.from.yaw) * progress;
+            angles.pitch = movement.from.pitch + (movement.to.pitch - movement.from.pitch) * progress;
+
+            return movement.type != MovementType::Blink;
+        }
+
+        MovementType GazeTrajectory::getMovementType(XrDuration time) {
+            return findMovement(time).type;
+        }
+
+        const Movement& GazeTrajectory::findMovement(XrDuration time) {
+            while (m_movements.back().end <= time) {
+                generateNextMovement();
+            }
+
+            auto it = std::upper_bound(
+                m_movements.cbegin(), m_movements.cend(), time, [](XrDuration time, const Movement& movement) {
+                    return time < movement.end;
+                });
+            return it != m_movements.cend() ? *it : m_movements.front();
+        }
+
+        void GazeTrajectory::generateNextMovement() {
+            const Movement& previous = m_movements.back();
+            Movement movement{};
+            movement.start = previous.end;
+            movement.from = previous.to;
+            movement.to = previous.to;
+
+            const float choice = m_random.uniform(0.f, 1.f);
+            if (previous.type != MovementType::Fixation) {
+                // Every other movement is a fixation.
+                movement.type = MovementType::Fixation;
+                movement.end = movement.start + (XrDuration)(m_random.uniform(0.15f, 0.45f) * 1e9f);
+            } else if (choice < 0.12f) {
+                // About 15 blinks per minute.
+                movement.type = MovementType::Blink;
+                movement.end = movement.start + (XrDuration)(m_random.uniform(0.1f, 0.3f) * 1e9f);
+            } else if (choice < 0.26f) {
+                // Follow a target moving at constant speed.
+                movement.type = MovementType::Pursuit;
+                const float duration = m_random.uniform(0.3f, 1.f);
+                const float speed = m_random.uniform(5.f, 30.f) * DegreesToRadians;
+                const float direction = m_random.uniform(0.f, 2.f * Pi);
+                movement.to.yaw =
+                    std::clamp(movement.from.yaw + speed * duration * std::cos(direction), -MaxYaw, MaxYaw);
+                movement.to.pitch =
+                    std::clamp(movement.from.pitch + speed * duration * std::sin(direction), -MaxPitch, MaxPitch);
+                movement.end = movement.start + (XrDuration)(duration * 1e9f);
+            } else {
+                movement.type = MovementType::Saccade;
+                movement.to.yaw = m_random.uniform(-MaxYaw, MaxYaw);
+                movement.to.pitch = m_random.uniform(-MaxPitch, MaxPitch);
+
+                // Main sequence: the peak velocity saturates with the amplitude.
+                const float amplitude =
+                    std::sqrt((movement.to.yaw - movement.from.yaw) * (movement.to.yaw - movement.from.yaw) +
+                              (movement.to.pitch - movement.from.pitch) * (movement.to.pitch - movement.from.pitch)) /
+                    DegreesToRadians;
+                const float peakVelocity = 500.f * (1.f - std::exp(-amplitude / 14.f)) + 1.f;
+                const float duration = std::max(1.875f * amplitude / peakVelocity, 0.01f);
+                movement.end = movement.start + (XrDuration)(duration * 1e9f);
+            }
+
+            m_movements.push_back(movement);
+            if (m_movements.size() > MaxMovements) {
+                m_movements.pop_front();
+            }
+        }
+
+    } // namespace synthetic
+
+    SyntheticGaze::SyntheticGaze(uint64_t seed, XrDuration latency)
+        : m_seed(seed), m_latency(latency), m_trajectory(seed) {
+    }
+
+    bool SyntheticGaze::getGazeSample(XrTime time, GazeSample& sample) {
+        sample.time = time - m_latency;
+        GazeAngles angles;
+        if (!m_trajectory.evaluate(sinceStart(sample.time), angles)) {
+            return false;
+        }
+
+        for (uint32_t eye = 0; eye < EyeCount; eye++) {
+            sample.eyeUnitVector[eye] =
+                FromAngles({angles.yaw + MeasurementNoise * Noise(m_seed, sample.time, 2 * eye),
+                            angles.pitch + MeasurementNoise * Noise(m_seed, sample.time, 2 * eye + 1)});
+        }
+        const XrVector3f& left = sample.eyeUnitVector[0];
+        const XrVector3f& right = sample.eyeUnitVector[1];
+        sample.unitVector = gaze::Normalize(XrVector3f{left.x + right.x, left.y + right.y, left.z + right.z});
+        sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+        sample.isValid = true;
+
+        return true;
+    }
+
+    XrVector3f SyntheticGaze::getTrueGaze(XrTime time) {
+        GazeAngles angles;
+        m_trajectory.evaluate(sinceStart(time), angles);
+        return FromAngles(angles);
+    }
+
+    MovementType SyntheticGaze::getMovementType(XrTime time) {
+        return m_trajectory.getMovementType(sinceStart(time));
+    }
+
+    XrDuration SyntheticGaze::sinceStart(XrTime time) {
+        if (!m_isStarted) {
+            m_startTime = time;
+            m_isStarted = true;
+        }
+        return time - m_startTime;
+    }
+
+} // namespace openxr_api_layer
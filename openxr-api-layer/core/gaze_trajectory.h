@@ -0,0 +1,133 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <deque>
+
+#include "gaze_history.h"
+
+namespace openxr_api_layer {
+
+    namespace synthetic {
+
+        // A portable generator, so that a seed produces the same trajectory with any standard library.
+        class SplitMix64 {
+          public:
+            explicit SplitMix64(uint64_t seed) : m_state(seed) {
+            }
+
+            uint64_t next() {
+                return Mix(m_state += 0x9e3779b97f4a7c15ull);
+            }
+
+            // Uniform in [min, max).
+            float uniform(float min, float max) {
+                return min + (max - min) * (float)((next() >> 40) * (1.0 / (1ull << 24)));
+            }
+
+            static uint64_t Mix(uint64_t z) {
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                return z ^ (z >> 31);
+            }
+
+          private:
+            uint64_t m_state;
+        };
+
+        struct GazeAngles {
+            float yaw{0.f};
+            float pitch{0.f};
+        };
+
+        // The unit vector looking yaw radians to the right and pitch radians up from -Z.
+        XrVector3f FromAngles(const GazeAngles& angles);
+
+        enum class MovementType {
+            Fixation,
+            Saccade,
+            Pursuit,
+            Blink,
+        };
+
+        struct Movement {
+            MovementType type;
+            XrDuration start;
+            XrDuration end;
+            GazeAngles from;
+            GazeAngles to;
+        };
+
+        // A gaze trajectory made of fixations, saccades, smooth pursuits and blinks. The trajectory only depends on the
+        // seed and on the time since the start, and not on when or how often it is queried.
+        class GazeTrajectory {
+          public:
+            explicit GazeTrajectory(uint64_t seed);
+
+            // The true gaze at the given time since the start. Returns false during blinks.
+            bool evaluate(XrDuration time, GazeAngles& angles);
+
+            // The movement at the given time since the start.
+            MovementType getMovementType(XrDuration time);
+
+          private:
+            const Movement& findMovement(XrDuration time);
+            void generateNextMovement();
+
+            SplitMix64 m_random;
+            std::deque<Movement> m_movements;
+        };
+
+    } // namespace synthetic
+
+    // A headless source of physiologically plausible gaze, for testing and for scoring the predictors. Samples are
+    // reported with a fixed latency and with measurement noise on each eye, while the true gaze is known at any time.
+    class SyntheticGaze {
+      public:
+        SyntheticGaze(uint64_t seed, XrDuration latency);
+
+        // The gaze as a tracker would report it when queried at the given time. Returns false during blinks.
+        bool getGazeSample(XrTime time, GazeSample& sample);
+
+        // The true gaze at the given time. The first query to either method sets the start of the trajectory.
+        XrVector3f getTrueGaze(XrTime time);
+
+        // The movement of the eyes at the given time.
+        synthetic::MovementType getMovementType(XrTime time);
+
+        XrDuration getLatency() const {
+            return m_latency;
+        }
+
+      private:
+        XrDuration sinceStart(XrTime time);
+
+        const uint64_t m_seed;
+        const XrDuration m_latency;
+        synthetic::GazeTrajectory m_trajectory;
+        XrTime m_startTime{0};
+        bool m_isStarted{false};
+    };
+
+} // namespace openxr_api_layer
@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstring>
+
+#include "osc.h"
+
+namespace openxr_api_layer::osc {
+
+    namespace {
+
+        // Bundles nested deeper than this are rejected, rather than recursing on untrusted input.
+        constexpr int MaxBundleDepth = 8;
+
+        constexpr char BundleTag[] = "#bundle";
+
+        uint32_t ReadUInt32(const char* data) {
+            const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+            return (uint32_t)bytes[0] << 24 | (uint32_t)bytes[1] << 16 | (uint32_t)bytes[2] << 8 | (uint32_t)bytes[3];
+        }
+
+        // Strings are null-terminated and padded to a multiple of 4 bytes.
+        bool ReadString(const char* data, size_t size, size_t& offset, std::string_view& value) {
+            const void* end = std::memchr(data + offset, '\0', size - offset);
+            if (!end) {
+                return false;
+            }
+
+            const size_t length = static_cast<const char*>(end) - (data + offset);
+            const size_t paddedLength = (length + 4) & ~(size_t)3;
+            if (paddedLength > size - offset) {
+                return false;
+            }
+
+            value = std::string_view(data + offset, length);
+            offset += paddedLength;
+            return true;
+        }
+
+        bool ParseMessage(const char* data, size_t size, const std::function<void(const Message&)>& handler) {
+            Message message;
+            size_t offset = 0;
+            if (!ReadString(data, size, offset, message.address) || message.address.empty() ||
+                message.address[0] != '/') {
+                return false;
+            }
+
+            // Very old senders may omit the type tags, in which case there are no arguments we can interpret.
+            if (offset < size) {
+                std::string_view typeTags;
+                if (!ReadString(data, size, offset, typeTags) || typeTags.empty() || typeTags[0] != ',') {
+                    return false;
+                }
+                message.typeTags = typeTags.substr(1);
+            }
+
+            message.arguments = data + offset;
+            message.argumentsSize = size - offset;
+            handler(message);
+            return true;
+        }
+
+        bool ParseElement(const char* data,
+                          size_t size,
+                          const std::function<void(const Message&)>& handler,
+                          int depth) {
+            if (size == 0 || size % 4) {
+                return false;
+            }
+
+            if (data[0] != '#') {
+                return ParseMessage(data, size, handler);
+            }
+
+            // A bundle is its tag, a 64-bit time tag, then elements prefixed with their size.
+            if (depth >= MaxBundleDepth || size < 16 || std::memcmp(data, BundleTag, sizeof(BundleTag))) {
+                return false;
+            }
+            size_t offset = 16;
+            while (offset < size) {
+                if (size - offset < 4) {
+                    return false;
+                }
+                const uint32_t elementSize = ReadUInt32(data + offset);
+                offset += 4;
+                if (elementSize > size - offset ||
+                    !ParseElement(data + offset, elementSize, handler, depth + 1)) {
+                    return false;
+                }
+                offset += elementSize;
+            }
+            return true;
+        }
+
+    } // namespace
+
+    bool Message::getFloats(float* values, size_t count) const {
+        if (typeTags.size() != count || typeTags.find_first_not_of('f') != std::string_view::npos ||
+            argumentsSize < count * 4) {
+            return false;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            const uint32_t bits = ReadUInt32(arguments + i * 4);
+            std::memcpy(&values[i], &bits, sizeof(float));
+        }
+        return true;
+    }
+
+    bool ParsePacket(const char* data, size_t size, const std::function<void(const Message&)>& handler) {
+        return ParseElement(data, size, handler, 0);
+    }
+
+} // namespace openxr_api_layer::osc
@@ -0,0 +1,50 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace openxr_api_layer::osc {
+
+    // A message received in an Open Sound Control packet. The views point into the packet.
+    struct Message {
+        std::string_view address;
+
+        // One character per argument, without the leading ','.
+        std::string_view typeTags;
+
+        const char* arguments{nullptr};
+        size_t argumentsSize{0};
+
+        // Read the arguments, which must be exactly `count` 32-bit floats.
+        bool getFloats(float* values, size_t count) const;
+    };
+
+    // Parse a packet holding a message or a (possibly nested) bundle of messages, and invoke the handler for each
+    // message. Returns false if the packet is malformed, in which case the messages preceding the malformed part were
+    // already handled.
+    bool ParsePacket(const char* data, size_t size, const std::function<void(const Message&)>& handler);
+
+} // namespace openxr_api_layer::osc
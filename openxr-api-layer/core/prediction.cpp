@@ -0,0 +1,266 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+
+#include "prediction.h"
+
+namespace openxr_api_layer {
+
+    namespace {
+
+        // Do not extrapolate further than this (seconds). Beyond that, the gaze has likely changed direction entirely.
+        constexpr double MaxPredictionHorizon = 0.05;
+
+        // Samples further apart than this (seconds) are considered discontinuous.
+        constexpr double MaxSampleGap = 0.1;
+
+        // Fastest plausible eye rotation (radians per second), reached during large saccades.
+        constexpr float MaxAngularVelocity = 12.f;
+
+        // We represent the gaze with yaw/pitch angles in view space. The eyes cannot rotate anywhere near the poles of
+        // that parameterization, so we can safely treat both angles independently.
+        struct GazeAngles {
+            float yaw{0.f};
+            float pitch{0.f};
+        };
+
+        GazeAngles ToAngles(const XrVector3f& unitVector) {
+            return {std::atan2(unitVector.x, -unitVector.z), std::asin(std::clamp(unitVector.y, -1.f, 1.f))};
+        }
+
+        XrVector3f FromAngles(const GazeAngles& angles) {
+            return {std::sin(angles.yaw) * std::cos(angles.pitch),
+                    std::sin(angles.pitch),
+                    -std::cos(angles.yaw) * std::cos(angles.pitch)};
+        }
+
+        double ToSeconds(XrDuration duration) {
+            return duration / 1e9;
+        }
+
+        float ClampVelocity(float velocity) {
+            return std::clamp(velocity, -MaxAngularVelocity, MaxAngularVelocity);
+        }
+
+        // Extrapolate from the last two samples.
+        class ConstantVelocityPredictor : public IGazePredictor {
+          public:
+            void reset() override {
+                m_hasSample = m_hasVelocity = false;
+                m_errorVariance = 0.f;
+            }
+
+            void update(const GazeSample& sample) override {
+                if (!sample.isValid) {
+                    reset();
+                    return;
+                }
+
+                const GazeAngles angles = ToAngles(sample.unitVector);
+                const double dt = m_hasSample ? ToSeconds(sample.time - m_lastTime) : 0.0;
+                if (!m_hasSample || dt <= 0.0 || dt > MaxSampleGap) {
+                    reset();
+                } else {
+                    if (m_hasVelocity) {
+                        // Track how well we would have predicted this sample.
+                        const float errorYaw = m_last.yaw + m_velocity.yaw * (float)dt - angles.yaw;
+                        const float errorPitch = m_last.pitch + m_velocity.pitch * (float)dt - angles.pitch;
+                        m_errorVariance =
+                            0.9f * m_errorVariance + 0.1f * (errorYaw * errorYaw + errorPitch * errorPitch);
+                    }
+                    m_velocity.yaw = ClampVelocity((angles.yaw - m_last.yaw) / (float)dt);
+                    m_velocity.pitch = ClampVelocity((angles.pitch - m_last.pitch) / (float)dt);
+                    m_sampleInterval = (float)dt;
+                    m_hasVelocity = true;
+                }
+
+                m_last = angles;
+                m_lastTime = sample.time;
+                m_hasSample = true;
+            }
+
+            bool predict(XrTime time, GazePrediction& prediction) const override {
+                if (!m_hasSample) {
+                    return false;
+                }
+
+                const float horizon = (float)std::clamp(ToSeconds(time - m_lastTime), 0.0, MaxPredictionHorizon);
+                GazeAngles angles = m_last;
+                if (m_hasVelocity) {
+                    angles.yaw += m_velocity.yaw * horizon;
+                    angles.pitch += m_velocity.pitch * horizon;
+                }
+                prediction.unitVector = FromAngles(angles);
+
+                // The one-step error grows linearly with the number of steps we extrapolate.
+                const float steps = m_hasVelocity ? horizon / m_sampleInterval : 0.f;
+                prediction.uncertainty = std::sqrt(m_errorVariance) * steps;
+
+                return true;
+            }
+
+            PredictorType getType() const override {
+                return PredictorType::ConstantVelocity;
+            }
+
+          private:
+            bool m_hasSample{false};
+            bool m_hasVelocity{false};
+            GazeAngles m_last;
+            GazeAngles m_velocity;
+            XrTime m_lastTime{0};
+            float m_sampleInterval{1.f};
+            float m_errorVariance{0.f};
+        };
+
+        // A Kalman filter with a constant-velocity motion model, run independently on each angle.
+        class KalmanPredictor : public IGazePredictor {
+            // Standard deviation of the tracker measurement noise (radians).
+            static constexpr float MeasurementNoise = 0.005f;
+
+            // Standard deviation of the white acceleration driving the motion model (radians per second squared).
+            static constexpr float ProcessNoise = 30.f;
+
+            // Initial standard deviation of the velocity (radians per second).
+            static constexpr float InitialVelocityNoise = 1.f;
+
+            // Innovations beyond this many standard deviations (eg: saccade onset) restart the filter.
+            static constexpr float InnovationGate = 5.f;
+
+            struct Axis {
+                float angle{0.f};
+                float velocity{0.f};
+                float p00{0.f}, p01{0.f}, p11{0.f};
+
+                void init(float measurement) {
+                    angle = measurement;
+                    velocity = 0.f;
+                    p00 = MeasurementNoise * MeasurementNoise;
+                    p01 = 0.f;
+                    p11 = InitialVelocityNoise * InitialVelocityNoise;
+                }
+
+                void propagate(float dt, float& predictedAngle, float& q00, float& q01, float& q11) const {
+                    const float q = ProcessNoise * ProcessNoise;
+                    predictedAngle = angle + velocity * dt;
+                    q00 = p00 + 2.f * dt * p01 + dt * dt * p11 + q * dt * dt * dt * dt / 4.f;
+                    q01 = p01 + dt * p11 + q * dt * dt * dt / 2.f;
+                    q11 = p11 + q * dt * dt;
+                }
+
+                // Returns false if the measurement was rejected.
+                bool update(float dt, float measurement) {
+                    float predictedAngle, q00, q01, q11;
+                    propagate(dt, predictedAngle, q00, q01, q11);
+
+                    const float innovation = measurement - predictedAngle;
+                    const float s = q00 + MeasurementNoise * MeasurementNoise;
+                    if (innovation * innovation > InnovationGate * InnovationGate * s) {
+                        return false;
+                    }
+
+                    const float k0 = q00 / s;
+                    const float k1 = q01 / s;
+                    angle = predictedAngle + k0 * innovation;
+                    velocity = ClampVelocity(velocity + k1 * innovation);
+                    p00 = (1.f - k0) * q00;
+                    p01 = (1.f - k0) * q01;
+                    p11 = q11 - k1 * q01;
+                    return true;
+                }
+            };
+
+          public:
+            void reset() override {
+                m_hasSample = false;
+            }
+
+            void update(const GazeSample& sample) override {
+                if (!sample.isValid) {
+                    reset();
+                    return;
+                }
+
+                const GazeAngles angles = ToAngles(sample.unitVector);
+                const double dt = m_hasSample ? ToSeconds(sample.time - m_lastTime) : 0.0;
+                if (!m_hasSample || dt > MaxSampleGap) {
+                    m_yaw.init(angles.yaw);
+                    m_pitch.init(angles.pitch);
+                } else if (dt > 0.0) {
+                    // Both axes must accept the measurement, otherwise we restart from it.
+                    Axis yaw = m_yaw, pitch = m_pitch;
+                    if (yaw.update((float)dt, angles.yaw) && pitch.update((float)dt, angles.pitch)) {
+                        m_yaw = yaw;
+                        m_pitch = pitch;
+                    } else {
+                        m_yaw.init(angles.yaw);
+                        m_pitch.init(angles.pitch);
+                    }
+                } else {
+                    return;
+                }
+
+                m_lastTime = sample.time;
+                m_hasSample = true;
+            }
+
+            bool predict(XrTime time, GazePrediction& prediction) const override {
+                if (!m_hasSample) {
+                    return false;
+                }
+
+                const float horizon = (float)std::clamp(ToSeconds(time - m_lastTime), 0.0, MaxPredictionHorizon);
+                GazeAngles angles;
+                float yaw00, pitch00, unused01, unused11;
+                m_yaw.propagate(horizon, angles.yaw, yaw00, unused01, unused11);
+                m_pitch.propagate(horizon, angles.pitch, pitch00, unused01, unused11);
+
+                prediction.unitVector = FromAngles(angles);
+                prediction.uncertainty = std::sqrt(yaw00 + pitch00);
+
+                return true;
+            }
+
+            PredictorType getType() const override {
+                return PredictorType::Kalman;
+            }
+
+          private:
+            bool m_hasSample{false};
+            Axis m_yaw;
+            Axis m_pitch;
+            XrTime m_lastTime{0};
+        };
+
+    } // namespace
+
+    std::unique_ptr<IGazePredictor> createConstantVelocityPredictor() {
+        return std::make_unique<ConstantVelocityPredictor>();
+    }
+
+    std::unique_ptr<IGazePredictor> createKalmanPredictor() {
+        return std::make_unique<KalmanPredictor>();
+    }
+
+} // namespace openxr_api_layer
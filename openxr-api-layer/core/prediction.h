@@ -0,0 +1,72 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "gaze_history.h"
+
+namespace openxr_api_layer {
+
+    enum class PredictorType {
+        None = 0,
+        ConstantVelocity,
+        Kalman,
+    };
+
+    static inline std::string getPredictorType(PredictorType type) {
+        switch (type) {
+        case PredictorType::None:
+            return "None";
+        case PredictorType::ConstantVelocity:
+            return "Constant velocity";
+        case PredictorType::Kalman:
+            return "Kalman";
+        }
+        return "<Unknown>";
+    }
+
+    struct GazePrediction {
+        // The predicted gaze direction, as a unit vector in view space.
+        XrVector3f unitVector{};
+
+        // The estimated standard deviation of the prediction error, in radians.
+        float uncertainty{0.f};
+    };
+
+    // A gaze predictor is fed with the samples from the eye tracker (in increasing time order), and extrapolates the
+    // gaze direction at a later time. Predictors are not thread-safe.
+    struct IGazePredictor {
+        virtual ~IGazePredictor() = default;
+
+        virtual void reset() = 0;
+        virtual void update(const GazeSample& sample) = 0;
+        virtual bool predict(XrTime time, GazePrediction& prediction) const = 0;
+        virtual PredictorType getType() const = 0;
+    };
+
+    std::unique_ptr<IGazePredictor> createConstantVelocityPredictor();
+    std::unique_ptr<IGazePredictor> createKalmanPredictor();
+
+} // namespace openxr_api_layer
@@ -0,0 +1,121 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace openxr_api_layer {
+
+    // An immutable value that writers replace as a whole, and that any number of threads read without locking.
+    // Replaced values are reclaimed once no reader may still hold them. Readers are counted in one of several
+    // cache lines picked per thread, so that threads reading concurrently do not contend on a single counter.
+    template <typename T>
+    class RcuValue {
+      public:
+        // Keeps the value it was given alive while in scope.
+        class ReadGuard {
+          public:
+            explicit ReadGuard(const RcuValue& owner) : m_readers(owner.m_readers[readerSlot()].count) {
+                m_readers.fetch_add(1);
+                m_value = owner.m_current.load();
+            }
+
+            ~ReadGuard() {
+                m_readers.fetch_sub(1, std::memory_order_release);
+            }
+
+            ReadGuard(const ReadGuard&) = delete;
+            ReadGuard& operator=(const ReadGuard&) = delete;
+
+            const T& operator*() const {
+                return *m_value;
+            }
+
+            const T* operator->() const {
+                return m_value;
+            }
+
+          private:
+            std::atomic<uint32_t>& m_readers;
+            const T* m_value;
+        };
+
+        RcuValue() : m_current(new T()) {
+        }
+
+        ~RcuValue() {
+            delete m_current.load();
+        }
+
+        RcuValue(const RcuValue&) = delete;
+        RcuValue& operator=(const RcuValue&) = delete;
+
+        ReadGuard read() const {
+            return ReadGuard(*this);
+        }
+
+        // Publish a modified copy of the current value. Writers are serialized with each other, but never with readers.
+        template <typename Update>
+        void update(Update&& update) {
+            std::unique_lock lock(m_writerMutex);
+
+            auto next = std::make_unique<T>(*m_current.load());
+            update(*next);
+            m_retired.emplace_back(m_current.exchange(next.release()));
+
+            // A reader arriving after the exchange can only see the new value, so if there is no reader now, none
+            // holds a retired value.
+            for (const auto& readers : m_readers) {
+                if (readers.count.load() != 0) {
+                    return;
+                }
+            }
+            m_retired.clear();
+        }
+
+      private:
+        static constexpr size_t ReaderSlots = 16;
+
+        struct alignas(64) ReaderCount {
+            std::atomic<uint32_t> count{0};
+        };
+
+        static size_t readerSlot() {
+            static std::atomic<size_t> nextSlot{0};
+            thread_local const size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % ReaderSlots;
+            return slot;
+        }
+
+        std::atomic<const T*> m_current;
+        mutable ReaderCount m_readers[ReaderSlots];
+
+        std::mutex m_writerMutex;
+        std::vector<std::unique_ptr<const T>> m_retired;
+    };
+
+} // namespace openxr_api_layer
@@ -0,0 +1,225 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "trace.h"
+
+namespace {
+
+    using namespace openxr_api_layer;
+
+    std::mutex g_captureMutex;
+    std::atomic<trace::Recorder*> g_recorder{nullptr};
+
+    int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+#ifdef _WIN32
+    uint32_t getThreadId() {
+        return GetCurrentThreadId();
+    }
+
+    uint32_t getProcessId() {
+        return GetCurrentProcessId();
+    }
+#else
+    // Number the threads in the order they first record, which keeps the identifiers short in the viewers.
+    uint32_t getThreadId() {
+        static std::atomic<uint32_t> nextThreadId{1};
+        thread_local const uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        return threadId;
+    }
+
+    uint32_t getProcessId() {
+        return (uint32_t)getpid();
+    }
+#endif
+
+    void writeNumber(std::ostream& out, double value) {
+        if (std::isfinite(value)) {
+            out << value;
+        } else {
+            out << "null";
+        }
+    }
+
+} // namespace
+
+namespace openxr_api_layer::trace {
+
+    Recorder::Recorder(size_t capacity)
+        : m_capacity(std::max(capacity, (size_t)1)), m_ring(std::make_unique<Slot[]>(m_capacity)) {
+    }
+
+    void Recorder::record(char phase, const char* name, std::initializer_list<Value> values) {
+        // The sequence orders the events of each thread even when their timestamps are equal.
+        const uint64_t sequence = m_nextSequence.fetch_add(1, std::memory_order_relaxed);
+        Event event{};
+        event.sequence = sequence;
+        event.timestamp = now();
+        event.name = name;
+        event.threadId = getThreadId();
+        event.phase = phase;
+        for (const auto& value : values) {
+            if (event.valueCount == MaxValuesPerEvent) {
+                break;
+            }
+            event.values[event.valueCount++] = value;
+        }
+
+        Slot& slot = m_ring[sequence % m_capacity];
+        if (!slot.isBusy.exchange(true, std::memory_order_acquire)) {
+            slot.event.store(event);
+            slot.isBusy.store(false, std::memory_order_release);
+        }
+    }
+
+    size_t Recorder::write(std::ostream& out) const {
+        std::vector<Event> events;
+        events.reserve(m_capacity);
+        for (size_t i = 0; i < m_capacity; i++) {
+            Event event;
+            if (m_ring[i].event.tryLoad(event) && event.name) {
+                events.push_back(event);
+            }
+        }
+
+        std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return a.sequence < b.sequence;
+        });
+
+        // Once the ring wrapped around, the beginning of the oldest spans may have been overwritten. Spans nest within a
+        // thread, so an end with no span open on its thread lost its beginning.
+        std::unordered_map<uint32_t, uint32_t> openSpans;
+        events.erase(std::remove_if(events.begin(),
+                                    events.end(),
+                                    [&](const Event& event) {
+                                        uint32_t& depth = openSpans[event.threadId];
+                                        if (event.phase == 'B') {
+                                            depth++;
+                                        } else if (event.phase == 'E') {
+                                            if (!depth) {
+                                                return true;
+                                            }
+                                            depth--;
+                                        }
+                                        return false;
+                                    }),
+                     events.end());
+
+        // Timestamps are in microseconds. Events of different threads may be slightly out of order, which the viewers
+        // accept.
+        int64_t origin = 0;
+        if (!events.empty()) {
+            origin = std::min_element(events.begin(), events.end(), [](const Event& a, const Event& b) {
+                         return a.timestamp < b.timestamp;
+                     })->timestamp;
+        }
+        const uint32_t processId = getProcessId();
+        out << std::fixed << std::setprecision(3);
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i = 0; i < events.size(); i++) {
+            const Event& event = events[i];
+            out << (i ? ",\n" : "\n") << "{\"name\":\"" << event.name << "\",\"ph\":\"" << event.phase
+                << "\",\"ts\":" << (event.timestamp - origin) / 1000.0 << ",\"pid\":" << processId
+                << ",\"tid\":" << event.threadId;
+            if (event.phase == 'i') {
+                out << ",\"s\":\"t\"";
+            }
+            if (event.valueCount) {
+                out << ",\"args\":{";
+                for (uint8_t j = 0; j < event.valueCount; j++) {
+                    out << (j ? "," : "") << "\"" << event.values[j].key << "\":";
+                    writeNumber(out, event.values[j].value);
+                }
+                out << "}";
+            }
+            out << "}";
+        }
+        out << "\n]}\n";
+
+        return events.size();
+    }
+
+    std::atomic<bool> g_isCapturing{false};
+
+    size_t StartCapture(size_t capacity) {
+        std::unique_lock lock(g_captureMutex);
+        Recorder* recorder = g_recorder.load(std::memory_order_relaxed);
+        if (!recorder) {
+            // The recorder is never freed, so that late events from other threads never see it go away.
+            recorder = new Recorder(capacity);
+            g_recorder.store(recorder, std::memory_order_release);
+        }
+
+        g_isCapturing.store(true, std::memory_order_release);
+        return recorder->getCapacity();
+    }
+
+    void StopCapture() {
+        g_isCapturing.store(false);
+    }
+
+    void RecordEvent(char phase, const char* name, std::initializer_list<Value> values) {
+        // The recorder is published before capture is enabled.
+        if (!g_isCapturing.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        g_recorder.load(std::memory_order_relaxed)->record(phase, name, values);
+    }
+
+    std::optional<size_t> DumpCapture(const std::filesystem::path& path) {
+        std::unique_lock lock(g_captureMutex);
+        const Recorder* recorder = g_recorder.load(std::memory_order_relaxed);
+        if (!recorder) {
+            return {};
+        }
+
+        std::ofstream out(path, std::ios_base::trunc);
+        if (!out.is_open()) {
+            return {};
+        }
+
+        return recorder->write(out);
+    }
+
+} // namespace openxr_api_layer::trace
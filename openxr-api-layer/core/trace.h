@@ -0,0 +1,126 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <ostream>
+
+#include "seqlock.h"
+
+// A flight recorder for the layer's own activities, independent of ETW. Spans and values are kept in an in-memory ring
+// and can be written out in the Chrome Trace Event format, which chrome://tracing and https://ui.perfetto.dev open.
+namespace openxr_api_layer::trace {
+
+    constexpr size_t MaxValuesPerEvent = 4;
+
+    // Names and keys are stored as pointers, so they must be string literals.
+    struct Value {
+        const char* key;
+        double value;
+    };
+
+    // A fixed-size ring of the most recent events. Recording is lock-free and may happen from any thread.
+    class Recorder {
+      public:
+        explicit Recorder(size_t capacity);
+
+        void record(char phase, const char* name, std::initializer_list<Value> values = {});
+
+        // Write the recorded events, oldest first, and return how many were written.
+        size_t write(std::ostream& out) const;
+
+        size_t getCapacity() const {
+            return m_capacity;
+        }
+
+      private:
+        struct Event {
+            uint64_t sequence;
+            int64_t timestamp;
+            const char* name;
+            uint32_t threadId;
+            char phase;
+            uint8_t valueCount;
+            Value values[MaxValuesPerEvent];
+        };
+
+        // Slots are claimed in order, so writers only collide when the ring wraps around during a write. In that case
+        // the newest event is dropped.
+        struct Slot {
+            std::atomic<bool> isBusy{false};
+            SeqLock<Event> event;
+        };
+
+        const size_t m_capacity;
+        const std::unique_ptr<Slot[]> m_ring;
+        std::atomic<uint64_t> m_nextSequence{0};
+    };
+
+    // Start recording, keeping the most recent events. The ring is allocated on the first start and kept afterwards.
+    // Returns the capacity of the ring.
+    size_t StartCapture(size_t capacity = 1 << 16);
+    void StopCapture();
+
+    // Write the recorded events, oldest first. Returns how many were written, or nothing if the file could not be
+    // written.
+    std::optional<size_t> DumpCapture(const std::filesystem::path& path);
+
+    extern std::atomic<bool> g_isCapturing;
+
+    static inline bool IsCapturing() {
+        return g_isCapturing.load(std::memory_order_relaxed);
+    }
+
+    void RecordEvent(char phase, const char* name, std::initializer_list<Value> values = {});
+
+    static inline void Instant(const char* name, std::initializer_list<Value> values = {}) {
+        if (IsCapturing()) {
+            RecordEvent('i', name, values);
+        }
+    }
+
+    // Record the lifetime of the object as a span.
+    class ScopedSpan {
+      public:
+        explicit ScopedSpan(const char* name) : m_name(IsCapturing() ? name : nullptr) {
+            if (m_name) {
+                RecordEvent('B', m_name);
+            }
+        }
+
+        ~ScopedSpan() {
+            if (m_name) {
+                RecordEvent('E', m_name);
+            }
+        }
+
+      private:
+        const char* const m_name;
+    };
+
+} // namespace openxr_api_layer::trace
@@ -0,0 +1,67 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+
+// The core only needs the plain OpenXR value types. When the OpenXR SDK is not available (eg: building the tests on
+// Linux), we declare a layout-compatible subset of them.
+#if __has_include(<openxr/openxr.h>)
+#include <openxr/openxr.h>
+#else
+typedef int64_t XrTime;
+typedef int64_t XrDuration;
+
+#if defined(__LP64__) || defined(_WIN64)
+typedef struct XrAction_T* XrAction;
+typedef struct XrSpace_T* XrSpace;
+#else
+typedef uint64_t XrAction;
+typedef uint64_t XrSpace;
+#endif
+
+typedef struct XrVector3f {
+    float x;
+    float y;
+    float z;
+} XrVector3f;
+
+typedef struct XrQuaternionf {
+    float x;
+    float y;
+    float z;
+    float w;
+} XrQuaternionf;
+
+typedef struct XrPosef {
+    XrQuaternionf orientation;
+    XrVector3f position;
+} XrPosef;
+#endif
+
+namespace openxr_api_layer {
+
+    // The number of eyes, indexed like xr::StereoView.
+    constexpr uint32_t EyeCount = 2;
+
+} // namespace openxr_api_layer
@@ -177,6 +177,10 @@ namespace openxr_api_layer {
                 result = XR_ERROR_RUNTIME_FAILURE;
             }
 
+            if (XR_SUCCEEDED(result)) {
+                StartLogWriter();
+            }
+
             // Cleanup attempt before returning an error.
             if (XR_FAILED(result)) {
                 PFN_xrDestroyInstance xrDestroyInstance = nullptr;
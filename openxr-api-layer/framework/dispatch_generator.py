@@ -38,6 +38,8 @@ from xrconventions import OpenXRConventions
 # Import configuration.
 import layer_apis
 
+from name_switch import genNameSwitch
+
 # Sanity checks on the configuration file
 for func in ['xrCreateInstance', 'xrDestroyInstance', 'xrEnumerateInstanceExtensionProperties']:
     if func in layer_apis.override_functions:
@@ -110,9 +112,11 @@ class DispatchGenCppOutputGenerator(DispatchGenOutputGenerator):
         preamble = '''#include "pch.h"
 
 #include <layer.h>
+#include <trace.h>
 
 #include "dispatch.h"
 #include "log.h"
+#include "profiling.h"
 
 using namespace openxr_api_layer::log;
 
@@ -129,6 +133,9 @@ namespace openxr_api_layer
 
 	void ResetInstance() {
 		g_instance.reset();
+
+		// Drain the log before the loader may unload us.
+		StopLogWriter();
 	}
 
 } // namespace openxr_api_layer
@@ -161,6 +168,11 @@ namespace openxr_api_layer
                     generated += f'''
 	XrResult XRAPI_CALL {cur_cmd.name}({parameters_list})
 	{{
+#ifdef LAYER_PROFILE_ENTRY_POINTS
+		static const uint32_t profilingEntryPoint = profiling::RegisterEntryPoint("{cur_cmd.name}");
+		const profiling::ScopedTimer profilingTimer(profilingEntryPoint);
+#endif
+		const trace::ScopedSpan traceSpan("{cur_cmd.name}");
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "{cur_cmd.name}");
 
@@ -188,6 +200,11 @@ namespace openxr_api_layer
                     generated += f'''
 	void XRAPI_CALL {cur_cmd.name}({parameters_list})
 	{{
+#ifdef LAYER_PROFILE_ENTRY_POINTS
+		static const uint32_t profilingEntryPoint = profiling::RegisterEntryPoint("{cur_cmd.name}");
+		const profiling::ScopedTimer profilingTimer(profilingEntryPoint);
+#endif
+		const trace::ScopedSpan traceSpan("{cur_cmd.name}");
 		TraceLocalActivity(local);
 		TraceLoggingWriteStart(local, "{cur_cmd.name}");
 
@@ -242,37 +259,33 @@ namespace openxr_api_layer
 	{
 		XrResult result = m_xrGetInstanceProcAddr(instance, name, function);
 
-		const std::string apiName(name);
-
-		if (apiName == "xrDestroyInstance")
-		{
-			m_xrDestroyInstance = reinterpret_cast<PFN_xrDestroyInstance>(*function);
-			*function = reinterpret_cast<PFN_xrVoidFunction>(openxr_api_layer::xrDestroyInstance);
-		}
+		const std::string_view apiName(name);
 '''
 
+        entries = [('xrDestroyInstance', [
+            'm_xrDestroyInstance = reinterpret_cast<PFN_xrDestroyInstance>(*function);',
+            '*function = reinterpret_cast<PFN_xrVoidFunction>(openxr_api_layer::xrDestroyInstance);'])]
+
         for cur_cmd in self.core_commands:
-            if cur_cmd.name in layer_apis.override_functions + ['xrEnumerateInstanceExtensionProperties']:
-                generated += f'''		else if (apiName == "{cur_cmd.name}")
-		{{
-			m_{cur_cmd.name} = reinterpret_cast<PFN_{cur_cmd.name}>(*function);
-			*function = reinterpret_cast<PFN_xrVoidFunction>(openxr_api_layer::{cur_cmd.name});
-		}}
-'''
+            if cur_cmd.name in ['xrEnumerateInstanceExtensionProperties']:
+                entries.append((cur_cmd.name, [
+                    f'm_{cur_cmd.name} = reinterpret_cast<PFN_{cur_cmd.name}>(*function);',
+                    f'*function = reinterpret_cast<PFN_xrVoidFunction>(openxr_api_layer::{cur_cmd.name});']))
 
-        # Always advertise extension functions.
-        for cur_cmd in self.ext_commands:
+        # Functions are only intercepted when downstream implements them, since the wrappers forward to it. This
+        # matters for extension functions, and for core functions newer than the runtime's API version.
+        for cur_cmd in self.core_commands + self.ext_commands:
             if cur_cmd.name in layer_apis.override_functions:
-                generated += f'''		else if (apiName == "{cur_cmd.name}")
-		{{
-			m_{cur_cmd.name} = reinterpret_cast<PFN_{cur_cmd.name}>(*function);
-			*function = reinterpret_cast<PFN_xrVoidFunction>(openxr_api_layer::{cur_cmd.name});
-			result = XR_SUCCESS;
-		}}
-'''
+                entries.append((cur_cmd.name, [
+                    'if (XR_SUCCEEDED(result))',
+                    '{',
+                    f'\tm_{cur_cmd.name} = reinterpret_cast<PFN_{cur_cmd.name}>(*function);',
+                    f'\t*function = reinterpret_cast<PFN_xrVoidFunction>(openxr_api_layer::{cur_cmd.name});',
+                    '}']))
 
-        generated += '''
+        generated += genNameSwitch(entries)
 
+        generated += '''
 		return result;
 	}'''
 
@@ -452,7 +465,7 @@ def makeREstring(strings, default=None):
 
 if __name__ == '__main__':
     conventions = OpenXRConventions()
-    featuresPat = 'XR_VERSION_1_0'
+    featuresPat = 'XR_VERSION_1_[01]'
     extensionsPat = makeREstring(layer_apis.extensions)
 
     registry = Registry(DispatchGenCppOutputGenerator(diagFile=None),
@@ -12,6 +12,8 @@ override_functions = [
     "xrWaitFrame",
     "xrBeginFrame",
     "xrLocateSpace",
+    "xrLocateSpaces",
+    "xrLocateSpacesKHR",
     "xrEnumerateBoundSourcesForAction",
     "xrGetInputSourceLocalizedName",
 ]
@@ -26,7 +28,8 @@ requested_functions = [
     "xrPathToString",
     "xrCreateEyeTrackerFB",
     "xrGetEyeGazesFB",
+    "xrConvertWin32PerformanceCounterToTimeKHR",
 ]
 
 # The list of OpenXR extensions our layer will either override or use.
-extensions = ['XR_EXT_eye_gaze_interaction', 'XR_FB_eye_tracking_social']
+extensions = ['XR_EXT_eye_gaze_interaction', 'XR_FB_eye_tracking_social', 'XR_KHR_win32_convert_performance_counter_time', 'XR_KHR_locate_spaces']
@@ -22,6 +22,8 @@
 
 #include "pch.h"
 
+#include "mpsc_ring.h"
+
 namespace {
     constexpr uint32_t k_maxLoggedErrors = 100;
     uint32_t g_globalErrorCount = 0;
@@ -39,21 +41,187 @@ namespace openxr_api_layer::log {
 
     namespace {
 
+        constexpr size_t k_maxRecordLength = 1024;
+
+        // Format the timestamp and the message. The timestamp only changes once per second, so it is reused between
+        // calls on the same thread.
+        void FormatRecord(char* buf, size_t size, const char* fmt, va_list va) {
+            thread_local std::time_t cachedTime = 0;
+            thread_local char cachedPrefix[64] = {};
+            thread_local size_t cachedPrefixLength = 0;
+
+            const std::time_t now = std::time(nullptr);
+            if (now != cachedTime) {
+                cachedPrefixLength =
+                    std::strftime(cachedPrefix, sizeof(cachedPrefix), "%Y-%m-%d %H:%M:%S %z: ", std::localtime(&now));
+                cachedTime = now;
+            }
+
+            const size_t offset = std::min(cachedPrefixLength, size - 1);
+            memcpy(buf, cachedPrefix, offset);
+            vsnprintf_s(buf + offset, size - offset, _TRUNCATE, fmt, va);
+        }
+
+        void FormatRecord(char* buf, size_t size, const char* fmt, ...) {
+            va_list va;
+            va_start(va, fmt);
+            FormatRecord(buf, size, fmt, va);
+            va_end(va);
+        }
+
+        void WriteRecord(const char* text) {
+            OutputDebugStringA(text);
+            if (logStream.is_open()) {
+                logStream << text;
+            }
+        }
+
+        // Records are formatted by the calling thread into a bounded multi-producer/single-consumer ring, and a
+        // background thread writes them out. Producers never block: when the ring is full, the record is dropped and
+        // counted.
+        class AsyncLogWriter {
+          public:
+            static constexpr size_t Capacity = 256;
+
+            ~AsyncLogWriter() {
+                // Only reached when the DLL is unloaded without the instance being destroyed. We cannot join a thread
+                // while holding the loader lock.
+                if (m_thread.joinable()) {
+                    m_thread.detach();
+                }
+            }
+
+            void start() {
+                std::unique_lock lock(m_controlMutex);
+                if (m_running.load()) {
+                    return;
+                }
+
+                m_wakeEvent.create(wil::EventOptions::None);
+                m_running.store(true);
+                m_thread = std::thread([this] { writerThread(); });
+            }
+
+            void stop() {
+                std::unique_lock lock(m_controlMutex);
+                if (!m_running.load()) {
+                    return;
+                }
+
+                // Wait for producers that already committed to the ring to publish their record.
+                m_running.store(false);
+                while (m_producers.load()) {
+                    std::this_thread::yield();
+                }
+
+                m_wakeEvent.SetEvent();
+                m_thread.join();
+                m_wakeEvent.reset();
+            }
+
+            // Returns false if the writer is not running, in which case the caller must write the record itself.
+            bool log(const char* fmt, va_list va) {
+                m_producers.fetch_add(1);
+                if (!m_running.load()) {
+                    m_producers.fetch_sub(1);
+                    return false;
+                }
+
+                const bool pushed = m_records.tryPush(
+                    [&](LogRecord& record) { FormatRecord(record.text, sizeof(record.text), fmt, va); });
+                if (!pushed) {
+                    m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+                    m_producers.fetch_sub(1);
+                    return true;
+                }
+
+                if (m_writerWaiting.load() && m_writerWaiting.exchange(false)) {
+                    m_wakeEvent.SetEvent();
+                }
+
+                m_producers.fetch_sub(1);
+                return true;
+            }
+
+          private:
+            struct LogRecord {
+                char text[k_maxRecordLength];
+            };
+
+            void writerThread() {
+                while (true) {
+                    bool wroteRecords = false;
+                    while (m_records.tryPop([](LogRecord& record) { WriteRecord(record.text); })) {
+                        wroteRecords = true;
+                    }
+
+                    const uint64_t droppedRecords = m_droppedRecords.exchange(0, std::memory_order_relaxed);
+                    if (droppedRecords) {
+                        TraceLoggingWrite(g_traceProvider, "Log_Dropped", TLArg(droppedRecords, "Count"));
+
+                        char buf[k_maxRecordLength];
+                        FormatRecord(buf, sizeof(buf), "%llu log records dropped\n", droppedRecords);
+                        WriteRecord(buf);
+                        wroteRecords = true;
+                    }
+
+                    // Flush once per batch rather than once per record.
+                    if (wroteRecords && logStream.is_open()) {
+                        logStream.flush();
+                    }
+
+                    // Once stopped, no more producers may enqueue, and we exit after the ring is drained.
+                    if (!m_running.load()) {
+                        if (!m_records.hasPending()) {
+                            break;
+                        }
+                        continue;
+                    }
+
+                    m_writerWaiting.store(true);
+                    if (!m_records.hasPending() && m_running.load()) {
+                        WaitForSingleObject(m_wakeEvent.get(), 100);
+                    }
+                    m_writerWaiting.store(false);
+                }
+            }
+
+            MpscRing<LogRecord, Capacity> m_records;
+            std::atomic<uint64_t> m_droppedRecords{0};
+            std::atomic<bool> m_writerWaiting{false};
+
+            std::atomic<bool> m_running{false};
+            std::atomic<uint32_t> m_producers{0};
+            std::mutex m_controlMutex;
+            wil::unique_event m_wakeEvent;
+            std::thread m_thread;
+        };
+
+        AsyncLogWriter g_logWriter;
+
         // Utility logging function.
         void InternalLog(const char* fmt, va_list va) {
-            const std::time_t now = std::time(nullptr);
+            if (g_logWriter.log(fmt, va)) {
+                return;
+            }
 
-            char buf[1024];
-            size_t offset = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S %z: ", std::localtime(&now));
-            vsnprintf_s(buf + offset, sizeof(buf) - offset, _TRUNCATE, fmt, va);
-            OutputDebugStringA(buf);
+            char buf[k_maxRecordLength];
+            FormatRecord(buf, sizeof(buf), fmt, va);
+            WriteRecord(buf);
             if (logStream.is_open()) {
-                logStream << buf;
                 logStream.flush();
             }
         }
     } // namespace
 
+    void StartLogWriter() {
+        g_logWriter.start();
+    }
+
+    void StopLogWriter() {
+        g_logWriter.stop();
+    }
+
     void Log(const char* fmt, ...) {
         va_list va;
         va_start(va, fmt);
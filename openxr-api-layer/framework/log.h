@@ -42,6 +42,20 @@ namespace openxr_api_layer::log {
 #define TLXArg TLPArg
 #endif
 
+// Structured fields for OpenXR types. Like all TraceLogging arguments, they are only evaluated when a trace session is
+// listening, and they avoid formatting strings when one is.
+#define TLVector2fArg(vec, name)                                                                                       \
+    TraceLoggingStruct(2, name), TraceLoggingFloat32((vec).x, "X"), TraceLoggingFloat32((vec).y, "Y")
+#define TLVector3fArg(vec, name)                                                                                       \
+    TraceLoggingStruct(3, name), TraceLoggingFloat32((vec).x, "X"), TraceLoggingFloat32((vec).y, "Y"),                 \
+        TraceLoggingFloat32((vec).z, "Z")
+#define TLQuaternionfArg(quat, name)                                                                                   \
+    TraceLoggingStruct(4, name), TraceLoggingFloat32((quat).x, "X"), TraceLoggingFloat32((quat).y, "Y"),               \
+        TraceLoggingFloat32((quat).z, "Z"), TraceLoggingFloat32((quat).w, "W")
+#define TLPosefArg(pose, name)                                                                                         \
+    TraceLoggingStruct(2, name), TLQuaternionfArg((pose).orientation, "Orientation"),                                  \
+        TLVector3fArg((pose).position, "Position")
+
     // General logging function.
     void Log(const char* fmt, ...);
     static inline void Log(const std::string_view& str) {
@@ -60,4 +74,8 @@ namespace openxr_api_layer::log {
         Log(str.data());
     }
 
+    // Move writing the log to a background thread. Until started (and once stopped), the log is written synchronously.
+    void StartLogWriter();
+    void StopLogWriter();
+
 } // namespace openxr_api_layer::log
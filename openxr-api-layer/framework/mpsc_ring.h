@@ -0,0 +1,108 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace openxr_api_layer {
+
+    // A bounded multi-producer/single-consumer queue. Each slot carries a sequence number telling whether it is free
+    // for the producer of a given position, or holds a value for the consumer. Producers never block: when the ring is
+    // full, pushing fails.
+    //
+    // Publishing and checking for a value are sequentially consistent, so that a consumer about to sleep can flag
+    // that it needs waking up without missing a value published concurrently.
+    template <typename T, size_t Capacity>
+    class MpscRing {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+
+      public:
+        MpscRing() {
+            for (size_t i = 0; i < Capacity; i++) {
+                m_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpscRing(const MpscRing&) = delete;
+        MpscRing& operator=(const MpscRing&) = delete;
+
+        // Claim a slot, write the value in place with `fill(T&)`, then publish it. Returns false if the ring is full.
+        template <typename Fill>
+        bool tryPush(Fill&& fill) {
+            Slot* slot;
+            uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+            while (true) {
+                slot = &m_slots[position & (Capacity - 1)];
+                const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+                const int64_t difference = (int64_t)sequence - (int64_t)position;
+                if (difference == 0) {
+                    if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    return false;
+                } else {
+                    position = m_enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            fill(slot->value);
+            slot->sequence.store(position + 1);
+            return true;
+        }
+
+        // Only the consumer thread may call the methods below.
+
+        bool hasPending() const {
+            const Slot& slot = m_slots[m_dequeuePosition & (Capacity - 1)];
+            return slot.sequence.load() == m_dequeuePosition + 1;
+        }
+
+        // Hand the oldest value to `consume(T&)`, then release its slot. Returns false if the ring is empty.
+        template <typename Consume>
+        bool tryPop(Consume&& consume) {
+            if (!hasPending()) {
+                return false;
+            }
+
+            Slot& slot = m_slots[m_dequeuePosition & (Capacity - 1)];
+            consume(slot.value);
+            slot.sequence.store(m_dequeuePosition + Capacity, std::memory_order_release);
+            m_dequeuePosition++;
+            return true;
+        }
+
+      private:
+        struct alignas(64) Slot {
+            std::atomic<uint64_t> sequence;
+            T value;
+        };
+
+        Slot m_slots[Capacity];
+        alignas(64) std::atomic<uint64_t> m_enqueuePosition{0};
+        alignas(64) uint64_t m_dequeuePosition{0};
+    };
+
+} // namespace openxr_api_layer
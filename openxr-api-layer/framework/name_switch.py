@@ -0,0 +1,65 @@
+# MIT License
+#
+# Copyright(c) 2021-2023 Matthieu Bucchianeri
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this softwareand associated documentation files(the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions :
+#
+# The above copyright noticeand this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Emits the lookup of xrGetInstanceProcAddr(). This does not depend on the OpenXR registry, so that the tests can run the
+# generator without the SDK.
+
+def genNameSwitch(entries):
+    '''Dispatch on the length of the name, then on a character that tells apart all the names of that length.'''
+    by_length = {}
+    for name, body in entries:
+        by_length.setdefault(len(name), []).append((name, body))
+
+    def genMatch(name, body, indent):
+        generated = f'{indent}if (apiName == "{name}")\n{indent}{{\n'
+        for line in body:
+            generated += f'{indent}\t{line}\n'
+        generated += f'{indent}}}\n'
+        return generated
+
+    generated = '\t\tswitch (apiName.size())\n\t\t{\n'
+    for length in sorted(by_length):
+        bucket = by_length[length]
+        generated += f'\t\tcase {length}:\n'
+
+        position = None
+        if len(bucket) > 1:
+            position = next((i for i in range(length) if len({n[i] for n, _ in bucket}) == len(bucket)), None)
+
+        if position is None:
+            for i, (name, body) in enumerate(bucket):
+                if i > 0:
+                    generated += '\t\t\telse '
+                    generated += genMatch(name, body, '\t\t\t').lstrip('\t')
+                else:
+                    generated += genMatch(name, body, '\t\t\t')
+        else:
+            generated += f'\t\t\tswitch (name[{position}])\n\t\t\t{{\n'
+            for name, body in sorted(bucket, key=lambda entry: entry[0][position]):
+                generated += f"\t\t\tcase '{name[position]}':\n"
+                generated += genMatch(name, body, '\t\t\t\t')
+                generated += '\t\t\t\tbreak;\n'
+            generated += '\t\t\t}\n'
+        generated += '\t\t\tbreak;\n'
+    generated += '\t\t}\n'
+
+    return generated
@@ -0,0 +1,166 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include <layer.h>
+
+#include "log.h"
+#include "profiling.h"
+
+#ifdef LAYER_PROFILE_ENTRY_POINTS
+
+namespace {
+
+    constexpr uint32_t MaxEntryPoints = 32;
+
+    // Log-linear buckets: each power of two is split into 4 buckets, which bounds the error to 25%.
+    constexpr uint32_t SubBucketBits = 2;
+    constexpr uint32_t SubBuckets = 1 << SubBucketBits;
+    constexpr uint32_t BucketCount = (64 - SubBucketBits + 1) * SubBuckets;
+
+    uint32_t getBucket(uint64_t ticks) {
+        if (ticks < SubBuckets) {
+            return (uint32_t)ticks;
+        }
+        unsigned long msb;
+        _BitScanReverse64(&msb, ticks);
+        const uint32_t shift = msb - SubBucketBits;
+        return ((shift + 1) << SubBucketBits) + (uint32_t)((ticks >> shift) & (SubBuckets - 1));
+    }
+
+    uint64_t getBucketLowerBound(uint32_t bucket) {
+        if (bucket < SubBuckets) {
+            return bucket;
+        }
+        const uint32_t shift = (bucket >> SubBucketBits) - 1;
+        return (uint64_t)(SubBuckets + (bucket & (SubBuckets - 1))) << shift;
+    }
+
+    // Each thread only ever writes its own histograms, so recording needs neither locks nor atomic read-modify-write.
+    struct ThreadHistograms {
+        std::atomic<uint64_t> buckets[MaxEntryPoints][BucketCount]{};
+    };
+
+    std::mutex g_registryMutex;
+    const char* g_entryPointNames[MaxEntryPoints]{};
+    uint32_t g_entryPointCount{0};
+    std::vector<std::unique_ptr<ThreadHistograms>> g_threadHistograms;
+    thread_local ThreadHistograms* t_histograms{nullptr};
+
+    // To convert TSC ticks into time.
+    uint64_t g_startTsc{0};
+    LARGE_INTEGER g_startQpc{};
+
+} // namespace
+
+namespace openxr_api_layer::profiling {
+
+    using namespace log;
+
+    uint32_t RegisterEntryPoint(const char* name) {
+        std::unique_lock lock(g_registryMutex);
+
+        if (!g_entryPointCount) {
+            QueryPerformanceCounter(&g_startQpc);
+            g_startTsc = __rdtsc();
+        }
+        if (g_entryPointCount == MaxEntryPoints) {
+            return MaxEntryPoints;
+        }
+        g_entryPointNames[g_entryPointCount] = name;
+        return g_entryPointCount++;
+    }
+
+    void RecordLatency(uint32_t entryPoint, uint64_t ticks) {
+        if (entryPoint >= MaxEntryPoints) {
+            return;
+        }
+
+        if (!t_histograms) {
+            std::unique_lock lock(g_registryMutex);
+            // Histograms outlive their thread, so that the samples of a terminated thread are still reported.
+            g_threadHistograms.push_back(std::make_unique<ThreadHistograms>());
+            t_histograms = g_threadHistograms.back().get();
+        }
+
+        std::atomic<uint64_t>& bucket = t_histograms->buckets[entryPoint][getBucket(ticks)];
+        bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    void DumpLatencies() {
+        std::unique_lock lock(g_registryMutex);
+
+        LARGE_INTEGER qpc, qpcFrequency;
+        QueryPerformanceCounter(&qpc);
+        QueryPerformanceFrequency(&qpcFrequency);
+        const double elapsed = (double)(qpc.QuadPart - g_startQpc.QuadPart) / qpcFrequency.QuadPart;
+        if (elapsed <= 0) {
+            return;
+        }
+        const double ticksPerMicrosecond = (double)(__rdtsc() - g_startTsc) / elapsed / 1e6;
+
+        std::ofstream file(localAppData / (LayerPrettyName + "-latency.csv"), std::ios_base::trunc);
+        file << "EntryPoint,Count,P50(us),P99(us),P999(us)\n";
+
+        for (uint32_t entryPoint = 0; entryPoint < g_entryPointCount; entryPoint++) {
+            uint64_t histogram[BucketCount]{};
+            uint64_t count = 0;
+            for (const auto& threadHistograms : g_threadHistograms) {
+                for (uint32_t i = 0; i < BucketCount; i++) {
+                    const uint64_t value = threadHistograms->buckets[entryPoint][i].load(std::memory_order_relaxed);
+                    histogram[i] += value;
+                    count += value;
+                }
+            }
+            if (!count) {
+                continue;
+            }
+
+            // Report the upper bound of the bucket where the percentile falls.
+            const auto percentile = [&](double p) {
+                const uint64_t rank = (uint64_t)std::ceil(p * count);
+                uint64_t cumulated = 0;
+                for (uint32_t i = 0; i < BucketCount; i++) {
+                    cumulated += histogram[i];
+                    if (cumulated >= rank) {
+                        return (i + 1 < BucketCount ? getBucketLowerBound(i + 1) : UINT64_MAX) /
+                               ticksPerMicrosecond;
+                    }
+                }
+                return 0.0;
+            };
+
+            const double p50 = percentile(0.5), p99 = percentile(0.99), p999 = percentile(0.999);
+            Log(fmt::format("{}: {} calls, p50 {:.1f}us, p99 {:.1f}us, p999 {:.1f}us\n",
+                            g_entryPointNames[entryPoint],
+                            count,
+                            p50,
+                            p99,
+                            p999));
+            file << fmt::format("{},{},{:.2f},{:.2f},{:.2f}\n", g_entryPointNames[entryPoint], count, p50, p99, p999);
+        }
+    }
+
+} // namespace openxr_api_layer::profiling
+
+#endif
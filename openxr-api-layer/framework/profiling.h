@@ -0,0 +1,56 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "pch.h"
+
+#ifdef LAYER_PROFILE_ENTRY_POINTS
+#include <intrin.h>
+#endif
+
+// Define LAYER_PROFILE_ENTRY_POINTS to record the latency of every overridden OpenXR function into histograms.
+namespace openxr_api_layer::profiling {
+
+#ifdef LAYER_PROFILE_ENTRY_POINTS
+    uint32_t RegisterEntryPoint(const char* name);
+    void RecordLatency(uint32_t entryPoint, uint64_t ticks);
+
+    // Write the p50/p99/p999 latencies of each entry point to the log and to a file.
+    void DumpLatencies();
+
+    class ScopedTimer {
+      public:
+        explicit ScopedTimer(uint32_t entryPoint) : m_entryPoint(entryPoint), m_start(__rdtsc()) {
+        }
+
+        ~ScopedTimer() {
+            RecordLatency(m_entryPoint, __rdtsc() - m_start);
+        }
+
+      private:
+        const uint32_t m_entryPoint;
+        const uint64_t m_start;
+    };
+#endif
+
+} // namespace openxr_api_layer::profiling
@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+namespace openxr_api_layer {
+
+    // A value published by a single writer and read by any number of threads without locking. Writes are wait-free, and
+    // reads only retry when they raced with a write.
+    //
+    // The value is stored as relaxed atomic words, so that readers racing with the writer see a torn (but well-defined)
+    // value, which they detect with the sequence counter.
+    template <typename T>
+    class SeqLock {
+        static_assert(std::is_trivially_copyable_v<T>, "Value must be trivially copyable");
+        static constexpr size_t WordCount = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+      public:
+        SeqLock() : SeqLock(T{}) {
+        }
+
+        explicit SeqLock(const T& value) {
+            uint64_t words[WordCount]{};
+            std::memcpy(words, &value, sizeof(value));
+            for (size_t i = 0; i < WordCount; i++) {
+                m_words[i].store(words[i], std::memory_order_relaxed);
+            }
+        }
+
+        // Only one thread may store at a time.
+        void store(const T& value) {
+            uint64_t words[WordCount]{};
+            std::memcpy(words, &value, sizeof(value));
+
+            const uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+            m_sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < WordCount; i++) {
+                m_words[i].store(words[i], std::memory_order_relaxed);
+            }
+            m_sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        // Read the value once. Returns false if the read raced with a write.
+        bool tryLoad(T& value) const {
+            const uint32_t sequence = m_sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                return false;
+            }
+
+            uint64_t words[WordCount];
+            for (size_t i = 0; i < WordCount; i++) {
+                words[i] = m_words[i].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) != sequence) {
+                return false;
+            }
+
+            std::memcpy(&value, words, sizeof(value));
+            return true;
+        }
+
+        T load() const {
+            T value;
+            while (!tryLoad(value)) {
+                std::this_thread::yield();
+            }
+            return value;
+        }
+
+      private:
+        std::atomic<uint32_t> m_sequence{0};
+        std::atomic<uint64_t> m_words[WordCount];
+    };
+
+} // namespace openxr_api_layer
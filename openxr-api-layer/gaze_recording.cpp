@@ -0,0 +1,272 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "gaze_recording.h"
+
+#include <log.h>
+
+namespace openxr_api_layer {
+
+    using namespace openxr_api_layer::log;
+    using namespace openxr_api_layer::recording;
+
+    namespace {
+
+        TrackerType TrackerTypeFromName(const std::string& name) {
+            // Replay is the last tracker type.
+            for (uint32_t i = 0; i <= (uint32_t)TrackerType::Replay; i++) {
+                if (getTrackerType((TrackerType)i) == name) {
+                    return (TrackerType)i;
+                }
+            }
+            return TrackerType::None;
+        }
+
+        class GazeRecorder : public IGazeRecorder {
+          public:
+            GazeRecorder(const std::filesystem::path& path, TrackerType trackerType) {
+                m_file.reset(CreateFileW(path.c_str(),
+                                         GENERIC_READ | GENERIC_WRITE,
+                                         FILE_SHARE_READ,
+                                         nullptr,
+                                         CREATE_ALWAYS,
+                                         FILE_ATTRIBUTE_NORMAL,
+                                         nullptr));
+                if (!m_file) {
+                    throw std::runtime_error("Failed to create the recording file");
+                }
+
+                // The file header takes the space of a whole chunk, so that chunks stay aligned.
+                m_window = mapWindow(0);
+
+                FileHeader header{};
+                memcpy(header.magic, Magic, sizeof(Magic));
+                header.version = Version;
+                header.chunkSize = ChunkSize;
+                const std::string trackerName = getTrackerType(trackerType);
+                strncpy_s(header.trackerName, trackerName.c_str(), _TRUNCATE);
+                memcpy(m_window.view, &header, sizeof(header));
+
+                m_fileSize = sizeof(header);
+
+                m_windowThread = std::thread([this] { prepareWindows(); });
+            }
+
+            ~GazeRecorder() override {
+                {
+                    std::unique_lock lock(m_windowMutex);
+                    m_isStopping = true;
+                }
+                m_windowCv.notify_one();
+                m_windowThread.join();
+
+                for (uint8_t* view : {m_window.view, m_nextWindow.view, m_retiredView}) {
+                    if (view) {
+                        UnmapViewOfFile(view);
+                    }
+                }
+
+                // Trim the unused part of the file, which is only possible once it is no longer mapped.
+                LARGE_INTEGER size;
+                size.QuadPart = (LONGLONG)m_fileSize;
+                SetFilePointerEx(m_file.get(), size, nullptr, FILE_BEGIN);
+                SetEndOfFile(m_file.get());
+
+                if (m_droppedRecords) {
+                    Log(fmt::format("Gaze recording dropped {} records\n", m_droppedRecords));
+                }
+            }
+
+            void record(XrTime queryTime, bool isValid, const GazeSample& sample) override {
+                if (m_isStopped) {
+                    return;
+                }
+                if (!m_chunkHeader || m_chunkHeader->usedBytes + MaxRecordSize > ChunkSize) {
+                    if (!nextChunk(queryTime)) {
+                        m_droppedRecords++;
+                        return;
+                    }
+                }
+
+                uint8_t* const start = reinterpret_cast<uint8_t*>(m_chunkHeader) + m_chunkHeader->usedBytes;
+                uint8_t* const out = WriteRecord(start, m_lastQueryTime, queryTime, isValid, sample);
+
+                // Only account for the record once it is complete.
+                m_chunkHeader->usedBytes += (uint32_t)(out - start);
+                m_chunkHeader->recordCount++;
+                m_lastQueryTime = queryTime;
+                m_fileSize = (uint64_t)m_chunk * ChunkSize + m_chunkHeader->usedBytes;
+            }
+
+          private:
+            // Only a few chunks of the file are mapped at a time, to spare the address space of 32-bit applications.
+            static constexpr uint32_t ChunksPerWindow = 64;
+
+            struct Window {
+                uint8_t* view{nullptr};
+                uint32_t firstChunk{0};
+            };
+
+            bool nextChunk(XrTime baseTime) {
+                const uint32_t chunk = m_chunkHeader ? m_chunk + 1 : 1;
+                if (chunk >= m_window.firstChunk + ChunksPerWindow && !nextWindow()) {
+                    return false;
+                }
+
+                m_chunk = chunk;
+                m_chunkHeader =
+                    reinterpret_cast<ChunkHeader*>(m_window.view + (size_t)(m_chunk - m_window.firstChunk) * ChunkSize);
+                m_chunkHeader->recordCount = 0;
+                m_chunkHeader->usedBytes = sizeof(ChunkHeader);
+                m_chunkHeader->baseTime = baseTime;
+                m_lastQueryTime = baseTime;
+                return true;
+            }
+
+            // Switch to the window prepared by the background thread, which unmaps the previous one.
+            bool nextWindow() {
+                {
+                    std::unique_lock lock(m_windowMutex);
+                    if (m_hasFailed) {
+                        m_isStopped = true;
+                        return false;
+                    }
+                    if (!m_nextWindow.view) {
+                        // Unlikely, since a window lasts for minutes.
+                        return false;
+                    }
+
+                    m_retiredView = m_window.view;
+                    m_window = std::exchange(m_nextWindow, {});
+                }
+                m_windowCv.notify_one();
+                return true;
+            }
+
+            void prepareWindows() {
+                std::unique_lock lock(m_windowMutex);
+                while (true) {
+                    m_windowCv.wait(lock, [&] {
+                        return m_isStopping || m_retiredView || (!m_nextWindow.view && !m_hasFailed);
+                    });
+                    if (m_isStopping) {
+                        break;
+                    }
+
+                    uint8_t* const retiredView = std::exchange(m_retiredView, nullptr);
+                    const bool needsWindow = !m_nextWindow.view && !m_hasFailed;
+                    const uint32_t firstChunk = m_window.firstChunk + ChunksPerWindow;
+                    lock.unlock();
+
+                    if (retiredView) {
+                        UnmapViewOfFile(retiredView);
+                    }
+                    Window window;
+                    if (needsWindow) {
+                        try {
+                            window = mapWindow(firstChunk);
+                        } catch (std::exception& exc) {
+                            ErrorLog(fmt::format("Gaze recording stopped: {}\n", exc.what()));
+                        }
+                    }
+
+                    lock.lock();
+                    if (needsWindow) {
+                        m_nextWindow = window;
+                        m_hasFailed = !window.view;
+                    }
+                }
+            }
+
+            // Mapping beyond the end of the file grows it.
+            Window mapWindow(uint32_t firstChunk) const {
+                const uint64_t offset = (uint64_t)firstChunk * ChunkSize;
+                const uint64_t end = offset + (uint64_t)ChunksPerWindow * ChunkSize;
+                wil::unique_handle mapping(CreateFileMappingW(
+                    m_file.get(), nullptr, PAGE_READWRITE, (DWORD)(end >> 32), (DWORD)end, nullptr));
+                if (!mapping) {
+                    throw std::runtime_error("Failed to map the recording file");
+                }
+
+                // The view keeps the mapping alive.
+                Window window;
+                window.view = reinterpret_cast<uint8_t*>(MapViewOfFile(mapping.get(),
+                                                                       FILE_MAP_WRITE,
+                                                                       (DWORD)(offset >> 32),
+                                                                       (DWORD)offset,
+                                                                       (size_t)ChunksPerWindow * ChunkSize));
+                if (!window.view) {
+                    throw std::runtime_error("Failed to map the recording file");
+                }
+                window.firstChunk = firstChunk;
+                return window;
+            }
+
+            wil::unique_hfile m_file;
+
+            // Only accessed by the recording thread.
+            Window m_window;
+            uint32_t m_chunk{0};
+            ChunkHeader* m_chunkHeader{nullptr};
+            XrTime m_lastQueryTime{0};
+            uint64_t m_fileSize{0};
+            uint64_t m_droppedRecords{0};
+            bool m_isStopped{false};
+
+            // Shared with the background thread.
+            std::mutex m_windowMutex;
+            std::condition_variable m_windowCv;
+            Window m_nextWindow;
+            uint8_t* m_retiredView{nullptr};
+            bool m_hasFailed{false};
+            bool m_isStopping{false};
+            std::thread m_windowThread;
+        };
+
+    } // namespace
+
+    std::unique_ptr<IGazeRecorder> createGazeRecorder(const std::filesystem::path& path, TrackerType trackerType) {
+        try {
+            return std::make_unique<GazeRecorder>(path, trackerType);
+        } catch (std::exception& exc) {
+            ErrorLog(fmt::format("Failed to record gaze to {}: {}\n", path.string(), exc.what()));
+            return {};
+        }
+    }
+
+    bool readGazeRecording(const std::filesystem::path& path,
+                           std::vector<RecordedGaze>& records,
+                           TrackerType& trackerType) {
+        std::ifstream file(path, std::ios_base::binary);
+        const std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        std::string trackerName;
+        if (!ParseRecording(data.data(), data.size(), records, trackerName)) {
+            return false;
+        }
+        trackerType = TrackerTypeFromName(trackerName);
+        return true;
+    }
+
+} // namespace openxr_api_layer
@@ -0,0 +1,48 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "trackers.h"
+#include <gaze_recording_format.h>
+
+namespace openxr_api_layer {
+
+    // Record the queries to the eye tracker into a memory-mapped file. Recording only copies a few bytes into a mapped
+    // window of the file, while a background thread grows the file and maps the next window ahead of time. Recorders
+    // are not thread-safe.
+    struct IGazeRecorder {
+        virtual ~IGazeRecorder() = default;
+
+        // The sample is only read when valid.
+        virtual void record(XrTime queryTime, bool isValid, const GazeSample& sample) = 0;
+    };
+
+    std::unique_ptr<IGazeRecorder> createGazeRecorder(const std::filesystem::path& path, TrackerType trackerType);
+
+    // Read a whole recording. Returns false if the file is not a valid recording. The tracker type is None when the
+    // recorded tracker does not exist in this build.
+    bool readGazeRecording(const std::filesystem::path& path,
+                           std::vector<RecordedGaze>& records,
+                           TrackerType& trackerType);
+
+} // namespace openxr_api_layer
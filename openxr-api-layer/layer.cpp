@@ -26,9 +26,15 @@
 #include "layer.h"
 #include "utils.h"
 #include <log.h>
+#include <profiling.h>
+#include <trace.h>
 #include <util.h>
 
 #include "trackers.h"
+#include "gaze_recording.h"
+#include <action_spaces.h>
+#include <prediction.h>
+#include <rcu.h>
 
 namespace openxr_api_layer {
 
@@ -44,8 +50,11 @@ namespace openxr_api_layer {
     // Note that we block and implicitly request XR_EXT_eye_gaze_interaction in order to allow passthrough of it to the
     // runtime, in case we detect after instance creation that the upstream API layers or runtime are adequate.
     const std::vector<std::string> blockedExtensions = {XR_EXT_EYE_GAZE_INTERACTION_EXTENSION_NAME};
+    //
+    // We implicitly request XR_KHR_win32_convert_performance_counter_time in order to timestamp gaze samples.
     const std::vector<std::string> implicitExtensions = {XR_EXT_EYE_GAZE_INTERACTION_EXTENSION_NAME,
-                                                         XR_FB_EYE_TRACKING_SOCIAL_EXTENSION_NAME};
+                                                         XR_FB_EYE_TRACKING_SOCIAL_EXTENSION_NAME,
+                                                         XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME};
 
     // This class implements our API layer.
     class OpenXrLayer : public openxr_api_layer::OpenXrApi {
@@ -112,13 +121,28 @@ namespace openxr_api_layer {
 
             XrInstanceProperties instanceProperties = {XR_TYPE_INSTANCE_PROPERTIES};
             CHECK_XRCMD(OpenXrApi::xrGetInstanceProperties(GetXrInstance(), &instanceProperties));
-            const auto runtimeName = fmt::format("{} {}.{}.{}",
-                                                 instanceProperties.runtimeName,
-                                                 XR_VERSION_MAJOR(instanceProperties.runtimeVersion),
-                                                 XR_VERSION_MINOR(instanceProperties.runtimeVersion),
-                                                 XR_VERSION_PATCH(instanceProperties.runtimeVersion));
-            TraceLoggingWrite(g_traceProvider, "xrCreateInstance", TLArg(runtimeName.c_str(), "RuntimeName"));
-            Log(fmt::format("Using OpenXR runtime: {}\n", runtimeName));
+            m_runtimeName = fmt::format("{} {}.{}.{}",
+                                        instanceProperties.runtimeName,
+                                        XR_VERSION_MAJOR(instanceProperties.runtimeVersion),
+                                        XR_VERSION_MINOR(instanceProperties.runtimeVersion),
+                                        XR_VERSION_PATCH(instanceProperties.runtimeVersion));
+            TraceLoggingWrite(g_traceProvider, "xrCreateInstance", TLArg(m_runtimeName.c_str(), "RuntimeName"));
+            Log(fmt::format("Using OpenXR runtime: {}\n", m_runtimeName));
+
+            // Configuration may request recording a trace that does not require ETW.
+            if (utilities::RegGetDword(HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "CaptureTrace")
+                    .value_or(false)) {
+                const size_t capacity = trace::StartCapture();
+                Log(fmt::format("Capturing trace events (up to {})\n", capacity));
+            }
+
+            // Resolve the paths we handle once, so that we only compare integers afterwards.
+            CHECK_XRCMD(OpenXrApi::xrStringToPath(
+                GetXrInstance(), "/interaction_profiles/ext/eye_gaze_interaction", &m_eyeGazeInteractionProfilePath));
+            CHECK_XRCMD(OpenXrApi::xrStringToPath(GetXrInstance(), "/user/eyes_ext", &m_userEyesPath));
+            CHECK_XRCMD(OpenXrApi::xrStringToPath(GetXrInstance(), "/user/eyes_ext/input/gaze_ext", &m_gazePath));
+            CHECK_XRCMD(
+                OpenXrApi::xrStringToPath(GetXrInstance(), "/user/eyes_ext/input/gaze_ext/pose", &m_gazePosePath));
 
             return XR_SUCCESS;
         }
@@ -156,51 +180,101 @@ namespace openxr_api_layer {
                     Log(fmt::format("Using OpenXR system: {}\n", systemName.data()));
 
                     m_trackerType = TrackerType::None;
+                    m_isPassthrough = false;
+                    {
+                        std::unique_lock lock(m_trackerProbeMutex);
+                        m_trackerProbe.reset();
+                        m_isProbingTracker = false;
+                    }
                     if (eyeGazeInteractionProperties.supportsEyeGazeInteraction &&
                         systemName.find("Windows Mixed Reality") == std::string::npos) {
                         // If the upstream API layers or runtime already support eye gaze interaction, we passthrough to
                         // it.
                         // Note: that WMR advertises eye gaze interaction, but it is not real on PC platforms.
                         m_trackerType = TrackerType::EyeGazeInteraction;
+                        m_isPassthrough = true;
                         Log(fmt::format(
                             "Upstream layer/runtime reported supportsEyeGazeInteraction, {} layer will be bypassed\n",
                             LayerName));
-                    } else if (utilities::RegGetDword(
+                    } else if (const auto simulateTracker = utilities::RegGetDword(
                                    HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "SimulateTracker")
-                                   .value_or(false)) {
-                        // Configuration requested the mouse simulated eye tracking.
-                        m_tracker = createSimulatedEyeTracker();
+                                   .value_or(0)) {
+                        if (simulateTracker == 2) {
+                            // Configuration requested the headless synthetic eye tracking.
+                            const XrDuration latency =
+                                utilities::RegGetDword(
+                                    HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "SimulationLatency")
+                                    .value_or(0) *
+                                1'000'000ll;
+                            m_tracker = createSyntheticEyeTracker(
+                                utilities::RegGetDword(
+                                    HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "SimulationSeed")
+                                    .value_or(1),
+                                latency);
+                        } else {
+                            // Configuration requested the mouse simulated eye tracking.
+                            m_tracker = createSimulatedEyeTracker();
+                        }
+                    } else if (const auto recording = utilities::RegGetString(
+                                   HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "ReplayRecording")) {
+                        // Configuration requested playing back a gaze recording.
+                        m_tracker = createReplayEyeTracker(
+                            *recording,
+                            !utilities::RegGetDword(
+                                 HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "ReplayAsFastAsPossible")
+                                 .value_or(false));
                     } else if (eyeTrackingProperties.supportsEyeTracking) {
                         // Quest Pro only supports "social eye tracking", which we can translate into eye gaze
                         // interaction.
                         m_tracker = createQuestProEyeTracker(*this);
                     } else {
-                        // Attempt to initialize external eye tracking API.
+                        // Attempt to initialize external eye tracking API. Some of the vendor SDKs take seconds to give
+                        // up when their service is not running, so the candidates are probed concurrently in the
+                        // background, and the tracker is only picked up once the probes have settled.
+                        std::vector<TrackerCandidate> candidates;
                         if (0) {
 #ifdef _WIN64
                         }  else if (systemName.find("Windows Mixed Reality") != std::string::npos ||
                                  systemName.find("SteamVR/OpenXR : holographic") != std::string::npos) {
-                            m_tracker = createOmniceptEyeTracker();
+                            candidates.push_back({getTrackerType(TrackerType::Omnicept),
+                                                  [this] { return createOmniceptEyeTracker(*this); }});
 #endif
                         } else if (systemName.find("SteamVR/OpenXR : aapvr") != std::string::npos) {
-                            m_tracker = createPimaxEyeTracker();
+                            candidates.push_back(
+                                {getTrackerType(TrackerType::Pimax), [this] { return createPimaxEyeTracker(*this); }});
                         } else if (systemName.find("SteamVR/OpenXR : oculus") != std::string::npos) {
-                            m_tracker = createVirtualDesktopEyeTracker();
-                            if (!m_tracker) {
-                                m_tracker = createSteamLinkEyeTracker();
-                            }
+                            candidates.push_back({getTrackerType(TrackerType::VirtualDesktop),
+                                                  [] { return createVirtualDesktopEyeTracker(); }});
+                            candidates.push_back({getTrackerType(TrackerType::SteamLink),
+                                                  [this] { return createSteamLinkEyeTracker(*this); }});
                         } else if (systemName.find("SteamVR/OpenXR") != std::string::npos) {
-                            m_tracker = createVarjoEyeTracker();
+                            candidates.push_back(
+                                {getTrackerType(TrackerType::Varjo), [this] { return createVarjoEyeTracker(*this); }});
                         }
-                    }
 
-                    if (m_tracker) {
-                        m_trackerType = m_tracker->getType();
-                        Log(fmt::format("Using eye tracking: {}\n", getTrackerType(m_trackerType)));
+                        if (!candidates.empty()) {
+                            const auto timeout = std::chrono::milliseconds(
+                                utilities::RegGetDword(
+                                    HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "ProbeTimeout")
+                                    .value_or(5000));
+
+                            // Start with the tracker found last time on this runtime and system, if any. The
+                            // candidates of higher priority are still probed, so that it cannot shadow them.
+                            m_trackerCacheKey = fmt::format("{} / {}", m_runtimeName, systemName.data());
+                            m_cachedTracker = loadCachedTracker(trackerCachePath(), m_trackerCacheKey);
+                            if (m_cachedTracker) {
+                                Log(fmt::format("Probing cached tracker early: {}\n", *m_cachedTracker));
+                            }
+
+                            std::unique_lock lock(m_trackerProbeMutex);
+                            m_trackerProbe =
+                                createTrackerProbe(std::move(candidates), timeout, m_cachedTracker.value_or(""));
+                            m_isProbingTracker = true;
+                        }
                     }
-                    TraceLoggingWrite(g_traceProvider, "xrGetSystem", TLArg((int)m_trackerType, "TrackerType"));
-                    if (m_trackerType == TrackerType::None) {
-                        Log("No supported eye tracking device found\n");
+
+                    if (!m_isProbingTracker) {
+                        setupTracker();
                     }
                 }
 
@@ -226,12 +300,21 @@ namespace openxr_api_layer {
 
             if (XR_SUCCEEDED(result)) {
                 if (isSystemHandled(systemId) && !isPassthrough()) {
+                    // The application is asking whether it can use the eye gaze, so this is where we must know. The
+                    // wait is bounded by the probe timeout.
+                    bool supportsEyeGazeInteraction;
+                    {
+                        std::unique_lock lock(m_gazeMutex);
+                        pollTrackerProbe(true /* wait */);
+                        supportsEyeGazeInteraction = m_trackerType != TrackerType::None;
+                    }
+
                     XrSystemEyeGazeInteractionPropertiesEXT* eyeGazeInteractionProperties =
                         reinterpret_cast<XrSystemEyeGazeInteractionPropertiesEXT*>(properties->next);
                     while (eyeGazeInteractionProperties) {
                         if (eyeGazeInteractionProperties->type == XR_TYPE_SYSTEM_EYE_GAZE_INTERACTION_PROPERTIES_EXT) {
                             eyeGazeInteractionProperties->supportsEyeGazeInteraction =
-                                m_trackerType != TrackerType::None ? XR_TRUE : XR_FALSE;
+                                supportsEyeGazeInteraction ? XR_TRUE : XR_FALSE;
 
                             TraceLoggingWrite(g_traceProvider,
                                               "xrGetSystemProperties",
@@ -270,8 +353,14 @@ namespace openxr_api_layer {
                 if (isSystemHandled(createInfo->systemId)) {
                     m_session = *session;
 
-                    if (m_tracker) {
-                        m_tracker->start(m_session);
+                    {
+                        // A tracker still being probed is started once the probes have settled.
+                        std::unique_lock lock(m_gazeMutex);
+                        if (m_tracker) {
+                            startTracker();
+                        } else {
+                            pollTrackerProbe();
+                        }
                     }
                     {
                         XrReferenceSpaceCreateInfo referenceSpaceInfo{XR_TYPE_REFERENCE_SPACE_CREATE_INFO};
@@ -293,10 +382,33 @@ namespace openxr_api_layer {
 
             if (XR_SUCCEEDED(result)) {
                 if (isSessionHandled(session)) {
+                    std::unique_lock lock(m_gazeMutex);
                     if (m_tracker) {
                         m_tracker->stop();
                     }
 
+                    if (m_gazeQueries) {
+                        Log(fmt::format("Gaze queries: {}, tracker queries: {} ({} saved)\n",
+                                        m_gazeQueries,
+                                        m_trackerQueries,
+                                        m_gazeQueries - m_trackerQueries));
+                    }
+                    m_gazeQueries = m_trackerQueries = 0;
+                    m_cachedGaze.reset();
+                    m_gazeRecorder.reset();
+
+#ifdef LAYER_PROFILE_ENTRY_POINTS
+                    profiling::DumpLatencies();
+#endif
+                    if (trace::IsCapturing()) {
+                        const auto tracePath = localAppData / (LayerPrettyName + "-trace.json");
+                        if (const auto eventCount = trace::DumpCapture(tracePath)) {
+                            Log(fmt::format("Wrote {} trace events to {}\n", *eventCount, tracePath.string()));
+                        } else {
+                            ErrorLog(fmt::format("Failed to write trace to {}\n", tracePath.string()));
+                        }
+                    }
+
                     m_session = XR_NULL_HANDLE;
                 }
             }
@@ -317,9 +429,8 @@ namespace openxr_api_layer {
                               TLArg(getXrPath(suggestedBindings->interactionProfile).c_str(), "InteractionProfile"));
 
             XrResult result = XR_ERROR_RUNTIME_FAILURE;
-            const std::string& interactionProfile = getXrPath(suggestedBindings->interactionProfile);
-            if (!isPassthrough() && interactionProfile == "/interaction_profiles/ext/eye_gaze_interaction") {
-                std::unique_lock lock(m_actionsAndSpacesMutex);
+            if (!isPassthrough() && suggestedBindings->interactionProfile == m_eyeGazeInteractionProfilePath) {
+                std::vector<XrAction> eyeGazeActions;
 
                 result = XR_SUCCESS;
                 for (uint32_t i = 0; i < suggestedBindings->countSuggestedBindings; i++) {
@@ -329,14 +440,18 @@ namespace openxr_api_layer {
                         TLXArg(suggestedBindings->suggestedBindings[i].action, "Action"),
                         TLArg(getXrPath(suggestedBindings->suggestedBindings[i].binding).c_str(), "Path"));
 
-                    const std::string& path = getXrPath(suggestedBindings->suggestedBindings[i].binding);
-                    if (path == "/user/eyes_ext/input/gaze_ext/pose" || path == "/user/eyes_ext/input/gaze_ext") {
-                        m_eyeGazeActions.insert(suggestedBindings->suggestedBindings[i].action);
+                    const XrPath path = suggestedBindings->suggestedBindings[i].binding;
+                    if (path == m_gazePosePath || path == m_gazePath) {
+                        eyeGazeActions.push_back(suggestedBindings->suggestedBindings[i].action);
                     } else {
                         result = XR_ERROR_PATH_UNSUPPORTED;
                     }
                 }
 
+                updateActionsAndSpaces([&](ActionsAndSpaces& actionsAndSpaces) {
+                    actionsAndSpaces.eyeGazeActions.insert(eyeGazeActions.cbegin(), eyeGazeActions.cend());
+                });
+
                 // We don't actually suggest the bindings, they would cause an error since the interaction profile is
                 // not supported.
             } else {
@@ -359,7 +474,7 @@ namespace openxr_api_layer {
                               TLXArg(session, "Session"),
                               TLXArg(createInfo->action, "Action"),
                               TLArg(getXrPath(createInfo->subactionPath).c_str(), "SubactionPath"),
-                              TLArg(xr::ToString(createInfo->poseInActionSpace).c_str(), "PoseInActionSpace"));
+                              TLPosefArg(createInfo->poseInActionSpace, "PoseInActionSpace"));
 
             const XrResult result = OpenXrApi::xrCreateActionSpace(session, createInfo, space);
 
@@ -367,12 +482,12 @@ namespace openxr_api_layer {
                 TraceLoggingWrite(g_traceProvider, "xrCreateActionSpace", TLXArg(*space, "Space"));
 
                 if (isSessionHandled(session) && !isPassthrough()) {
-                    std::unique_lock lock(m_actionsAndSpacesMutex);
-
-                    ActionSpace actionSpace{};
-                    actionSpace.action = createInfo->action;
-                    actionSpace.pose = createInfo->poseInActionSpace;
-                    m_actionSpaces.insert_or_assign(*space, actionSpace);
+                    updateActionsAndSpaces([&](ActionsAndSpaces& actionsAndSpaces) {
+                        ActionSpace actionSpace{};
+                        actionSpace.action = createInfo->action;
+                        actionSpace.pose = createInfo->poseInActionSpace;
+                        actionsAndSpaces.actionSpaces.insert_or_assign(*space, actionSpace);
+                    });
                 }
             }
 
@@ -383,12 +498,11 @@ namespace openxr_api_layer {
         XrResult xrDestroySpace(XrSpace space) override {
             TraceLoggingWrite(g_traceProvider, "xrDestroySpace", TLXArg(space, "Space"));
 
-            std::unique_lock lock(m_actionsAndSpacesMutex);
-
             const XrResult result = OpenXrApi::xrDestroySpace(space);
 
-            if (XR_SUCCEEDED(result)) {
-                m_actionSpaces.erase(space);
+            if (XR_SUCCEEDED(result) && m_actionsAndSpaces.read()->actionSpaces.count(space)) {
+                updateActionsAndSpaces(
+                    [&](ActionsAndSpaces& actionsAndSpaces) { actionsAndSpaces.actionSpaces.erase(space); });
             }
 
             return result;
@@ -442,37 +556,27 @@ namespace openxr_api_layer {
                               TLXArg(baseSpace, "BaseSpace"),
                               TLArg(time, "Time"));
 
-            std::unique_lock lock(m_actionsAndSpacesMutex);
-
             XrPosef queryPoseOffset;
-            bool isQueryEyeGaze = false;
-            {
-                auto it = m_actionSpaces.find(space);
-                if (it != m_actionSpaces.end()) {
-                    if (!it->second.isEyeGaze) {
-                        it->second.isEyeGaze = !!m_eyeGazeActions.count(it->second.action);
-                    }
-                    isQueryEyeGaze = it->second.isEyeGaze.value();
-                    queryPoseOffset = it->second.pose;
-                }
-            }
-
             XrPosef basePoseOffset;
+            bool isQueryEyeGaze = false;
             bool isBaseEyeGaze = false;
-            {
-                auto it = m_actionSpaces.find(baseSpace);
-                if (it != m_actionSpaces.end()) {
-                    if (!it->second.isEyeGaze) {
-                        it->second.isEyeGaze = !!m_eyeGazeActions.count(it->second.action);
-                    }
-                    isBaseEyeGaze = it->second.isEyeGaze.value();
-                    basePoseOffset = it->second.pose;
-                }
+            if (m_hasEyeGazeSpaces.load(std::memory_order_acquire)) {
+                const auto actionsAndSpaces = m_actionsAndSpaces.read();
+                isQueryEyeGaze = actionsAndSpaces->findEyeGazeSpace(space, queryPoseOffset);
+                isBaseEyeGaze = actionsAndSpaces->findEyeGazeSpace(baseSpace, basePoseOffset);
             }
 
             XrResult result = XR_ERROR_RUNTIME_FAILURE;
             if (isQueryEyeGaze || isBaseEyeGaze) {
                 assert(!isPassthrough());
+                XrSpaceVelocity* velocity = reinterpret_cast<XrSpaceVelocity*>(location->next);
+                while (velocity && velocity->type != XR_TYPE_SPACE_VELOCITY) {
+                    velocity = reinterpret_cast<XrSpaceVelocity*>(velocity->next);
+                }
+                if (velocity) {
+                    velocity->velocityFlags = 0;
+                }
+
                 // TODO: Support the notion of (in)active actionsets and actionset priority.
                 if (isQueryEyeGaze && isBaseEyeGaze) {
                     location->pose = Pose::Multiply(queryPoseOffset, Pose::Invert(basePoseOffset));
@@ -482,23 +586,22 @@ namespace openxr_api_layer {
                     result = XR_SUCCESS;
                 } else {
                     location->locationFlags = 0;
-                    XrVector3f gazeUnitVector;
-                    if (getEyeGaze(time, false, gazeUnitVector)) {
+                    XrQuaternionf gazeOrientation;
+                    XrTime sampleTime;
+                    if (getEyeGaze(time, gazeOrientation, sampleTime)) {
                         XrSpaceLocation viewToSpace{XR_TYPE_SPACE_LOCATION};
                         result = OpenXrApi::xrLocateSpace(
                             m_viewSpace, isQueryEyeGaze ? baseSpace : space, time, &viewToSpace);
                         TraceLoggingWrite(
                             g_traceProvider, "xrLocateSpace_LocateViewSpace", TLArg(xr::ToCString(result), "Result"));
                         if (XR_SUCCEEDED(result) && Pose::IsPoseValid(viewToSpace.locationFlags)) {
-                            const XrPosef eyeGazeToView = Pose::MakePose(
-                                Quaternion::RotationRollPitchYaw({tan(gazeUnitVector.y), -tan(gazeUnitVector.x), 0.f}),
-                                XrVector3f{0, 0, 0});
-
-                            location->pose = Pose::Multiply(
-                                Pose::Multiply(eyeGazeToView, isQueryEyeGaze ? queryPoseOffset : basePoseOffset),
-                                viewToSpace.pose);
+                            location->pose = locateEyeGaze(
+                                gazeOrientation, isQueryEyeGaze ? queryPoseOffset : basePoseOffset, viewToSpace.pose);
                             if (isBaseEyeGaze) {
                                 location->pose = Pose::Invert(location->pose);
+                                if (velocity) {
+                                    locateVelocityInEyeGaze(space, time, gazeOrientation, basePoseOffset, *velocity);
+                                }
                             }
 
                             location->locationFlags = viewToSpace.locationFlags;
@@ -508,8 +611,7 @@ namespace openxr_api_layer {
                                 reinterpret_cast<XrEyeGazeSampleTimeEXT*>(location->next);
                             while (gazeSampleTime) {
                                 if (gazeSampleTime->type == XR_TYPE_EYE_GAZE_SAMPLE_TIME_EXT) {
-                                    // TODO: Handle sample time for trackers that support it.
-                                    gazeSampleTime->time = time;
+                                    gazeSampleTime->time = sampleTime;
                                     break;
                                 }
                                 gazeSampleTime = reinterpret_cast<XrEyeGazeSampleTimeEXT*>(gazeSampleTime->next);
@@ -531,7 +633,195 @@ namespace openxr_api_layer {
                 TraceLoggingWrite(g_traceProvider,
                                   "xrLocateSpace",
                                   TLArg(location->locationFlags, "LocationFlags"),
-                                  TLArg(xr::ToString(location->pose).c_str(), "Pose"));
+                                  TLPosefArg(location->pose, "Pose"));
+            }
+
+            return result;
+        }
+
+        // https://registry.khronos.org/OpenXR/specs/1.1/html/xrspec.html#xrLocateSpaces
+        XrResult xrLocateSpaces(XrSession session,
+                                const XrSpacesLocateInfo* locateInfo,
+                                XrSpaceLocations* spaceLocations) override {
+            return locateSpaces(
+                session,
+                locateInfo,
+                spaceLocations,
+                [this](XrSession session, const XrSpacesLocateInfo* locateInfo, XrSpaceLocations* spaceLocations) {
+                    return OpenXrApi::xrLocateSpaces(session, locateInfo, spaceLocations);
+                });
+        }
+
+        // https://registry.khronos.org/OpenXR/specs/1.0/html/xrspec.html#xrLocateSpacesKHR
+        XrResult xrLocateSpacesKHR(XrSession session,
+                                   const XrSpacesLocateInfoKHR* locateInfo,
+                                   XrSpaceLocationsKHR* spaceLocations) override {
+            return locateSpaces(
+                session,
+                locateInfo,
+                spaceLocations,
+                [this](XrSession session,
+                       const XrSpacesLocateInfoKHR* locateInfo,
+                       XrSpaceLocationsKHR* spaceLocations) {
+                    return OpenXrApi::xrLocateSpacesKHR(session, locateInfo, spaceLocations);
+                });
+        }
+
+        // The core function and the extension function share their structures, only the downstream call differs.
+        template <typename LocateSpaces>
+        XrResult locateSpaces(XrSession session,
+                              const XrSpacesLocateInfo* locateInfo,
+                              XrSpaceLocations* spaceLocations,
+                              LocateSpaces downstreamLocateSpaces) {
+            if (locateInfo->type != XR_TYPE_SPACES_LOCATE_INFO_KHR ||
+                spaceLocations->type != XR_TYPE_SPACE_LOCATIONS_KHR) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+            if (locateInfo->spaceCount != spaceLocations->locationCount) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+
+            TraceLoggingWrite(g_traceProvider,
+                              "xrLocateSpaces",
+                              TLXArg(session, "Session"),
+                              TLXArg(locateInfo->baseSpace, "BaseSpace"),
+                              TLArg(locateInfo->time, "Time"),
+                              TLArg(locateInfo->spaceCount, "SpaceCount"));
+
+            if (!m_hasEyeGazeSpaces.load(std::memory_order_acquire)) {
+                return downstreamLocateSpaces(session, locateInfo, spaceLocations);
+            }
+
+            // Split the eye gaze spaces out of the batch.
+            std::vector<std::pair<uint32_t, XrPosef>> eyeGazeSpaces;
+            bool isBaseEyeGaze;
+            {
+                const auto actionsAndSpaces = m_actionsAndSpaces.read();
+                XrPosef pose;
+                isBaseEyeGaze = actionsAndSpaces->findEyeGazeSpace(locateInfo->baseSpace, pose);
+                for (uint32_t i = 0; i < locateInfo->spaceCount; i++) {
+                    if (actionsAndSpaces->findEyeGazeSpace(locateInfo->spaces[i], pose)) {
+                        eyeGazeSpaces.push_back({i, pose});
+                    }
+                }
+            }
+
+            if (eyeGazeSpaces.empty() && !isBaseEyeGaze) {
+                return downstreamLocateSpaces(session, locateInfo, spaceLocations);
+            }
+
+            XrSpaceVelocitiesKHR* velocities = reinterpret_cast<XrSpaceVelocitiesKHR*>(spaceLocations->next);
+            while (velocities && velocities->type != XR_TYPE_SPACE_VELOCITIES_KHR) {
+                velocities = reinterpret_cast<XrSpaceVelocitiesKHR*>(velocities->next);
+            }
+            if (velocities && velocities->velocityCount != spaceLocations->locationCount) {
+                return XR_ERROR_VALIDATION_FAILURE;
+            }
+
+            XrResult result = XR_ERROR_RUNTIME_FAILURE;
+            if (isBaseEyeGaze) {
+                // Relative to an eye gaze space, every space needs the gaze. This is unusual enough to not batch.
+                result = XR_SUCCESS;
+                for (uint32_t i = 0; i < locateInfo->spaceCount && XR_SUCCEEDED(result); i++) {
+                    XrSpaceVelocity velocity{XR_TYPE_SPACE_VELOCITY};
+                    XrSpaceLocation location{XR_TYPE_SPACE_LOCATION, velocities ? &velocity : nullptr};
+                    result = xrLocateSpace(locateInfo->spaces[i], locateInfo->baseSpace, locateInfo->time, &location);
+                    spaceLocations->locations[i].locationFlags = location.locationFlags;
+                    spaceLocations->locations[i].pose = location.pose;
+                    if (velocities) {
+                        velocities->velocities[i].velocityFlags = velocity.velocityFlags;
+                        velocities->velocities[i].linearVelocity = velocity.linearVelocity;
+                        velocities->velocities[i].angularVelocity = velocity.angularVelocity;
+                    }
+                }
+                return result;
+            }
+
+            // Forward everything else in one call, along with the view space that the gaze is relative to.
+            XrQuaternionf gazeOrientation;
+            XrTime sampleTime;
+            const bool isGazeValid = getEyeGaze(locateInfo->time, gazeOrientation, sampleTime);
+
+            std::vector<XrSpace> spaces;
+            std::vector<uint32_t> indices;
+            spaces.reserve(locateInfo->spaceCount - eyeGazeSpaces.size() + 1);
+            indices.reserve(spaces.capacity());
+            for (uint32_t i = 0, next = 0; i < locateInfo->spaceCount; i++) {
+                if (next < eyeGazeSpaces.size() && eyeGazeSpaces[next].first == i) {
+                    next++;
+                    continue;
+                }
+                spaces.push_back(locateInfo->spaces[i]);
+                indices.push_back(i);
+            }
+            const size_t viewIndex = spaces.size();
+            if (isGazeValid) {
+                spaces.push_back(m_viewSpace);
+            }
+
+            std::vector<XrSpaceLocationDataKHR> locationData(spaces.size());
+            std::vector<XrSpaceVelocityDataKHR> velocityData(velocities ? spaces.size() : 0);
+            result = XR_SUCCESS;
+            if (!spaces.empty()) {
+                XrSpacesLocateInfoKHR forwardLocateInfo = *locateInfo;
+                forwardLocateInfo.spaceCount = (uint32_t)spaces.size();
+                forwardLocateInfo.spaces = spaces.data();
+                XrSpaceVelocitiesKHR forwardVelocities{XR_TYPE_SPACE_VELOCITIES_KHR};
+                forwardVelocities.velocityCount = (uint32_t)velocityData.size();
+                forwardVelocities.velocities = velocityData.data();
+                XrSpaceLocationsKHR forwardLocations{XR_TYPE_SPACE_LOCATIONS_KHR, spaceLocations->next};
+                forwardLocations.locationCount = (uint32_t)locationData.size();
+                forwardLocations.locations = locationData.data();
+
+                // Forward the application's chain, with our own velocities standing in for the ones sized for all its
+                // spaces for the duration of the call.
+                XrBaseOutStructure* velocitiesLink = reinterpret_cast<XrBaseOutStructure*>(&forwardLocations);
+                if (velocities) {
+                    while (velocitiesLink->next != reinterpret_cast<XrBaseOutStructure*>(velocities)) {
+                        velocitiesLink = velocitiesLink->next;
+                    }
+                    forwardVelocities.next = velocities->next;
+                    velocitiesLink->next = reinterpret_cast<XrBaseOutStructure*>(&forwardVelocities);
+                }
+
+                result = downstreamLocateSpaces(session, &forwardLocateInfo, &forwardLocations);
+
+                if (velocities) {
+                    velocitiesLink->next = reinterpret_cast<XrBaseOutStructure*>(velocities);
+                }
+                TraceLoggingWrite(
+                    g_traceProvider, "xrLocateSpaces_Forward", TLArg(xr::ToCString(result), "Result"));
+
+                // Workaround for DCS loading screen, be tolerant to gaps in XrTime when only locating the gaze.
+                if (result == XR_ERROR_TIME_INVALID && indices.empty()) {
+                    result = XR_SUCCESS;
+                    locationData.back().locationFlags = 0;
+                }
+                if (XR_FAILED(result)) {
+                    return result;
+                }
+            }
+
+            for (size_t i = 0; i < indices.size(); i++) {
+                spaceLocations->locations[indices[i]] = locationData[i];
+                if (velocities) {
+                    velocities->velocities[indices[i]] = velocityData[i];
+                }
+            }
+
+            // All the eye gaze spaces share the same sample.
+            const bool isViewValid = isGazeValid && Pose::IsPoseValid(locationData[viewIndex].locationFlags);
+            for (const auto& [index, poseOffset] : eyeGazeSpaces) {
+                XrSpaceLocationDataKHR& location = spaceLocations->locations[index];
+                if (isViewValid) {
+                    location.pose = locateEyeGaze(gazeOrientation, poseOffset, locationData[viewIndex].pose);
+                    location.locationFlags = locationData[viewIndex].locationFlags;
+                } else {
+                    location.locationFlags = 0;
+                }
+                if (velocities) {
+                    velocities->velocities[index].velocityFlags = 0;
+                }
             }
 
             return result;
@@ -551,13 +841,12 @@ namespace openxr_api_layer {
                               TLXArg(getInfo->action, "Action"),
                               TLArg(getXrPath(getInfo->subactionPath).c_str(), "SubactionPath"));
 
-            std::unique_lock lock(m_actionsAndSpacesMutex);
-
             XrResult result = XR_ERROR_RUNTIME_FAILURE;
-            if (isSessionHandled(session) && !isPassthrough() && m_eyeGazeActions.count(getInfo->action)) {
+            if (isSessionHandled(session) && !isPassthrough() && isEyeGazeAction(getInfo->action)) {
                 // TODO: Support the notion of (in)active actionsets and actionset priority.
-                XrVector3f dummy{};
-                state->isActive = getEyeGaze(m_lastFrameBegunTime, true, dummy) ? XR_TRUE : XR_FALSE;
+                XrQuaternionf dummy{};
+                XrTime dummyTime;
+                state->isActive = getEyeGaze(m_lastFrameBegunTime, dummy, dummyTime) ? XR_TRUE : XR_FALSE;
                 result = XR_SUCCESS;
             } else {
                 result = OpenXrApi::xrGetActionStatePose(session, getInfo, state);
@@ -584,10 +873,8 @@ namespace openxr_api_layer {
                               TLArg(getXrPath(topLevelUserPath).c_str(), "TopLevelUserPath"));
 
             XrResult result = XR_ERROR_RUNTIME_FAILURE;
-            if (isSessionHandled(session) && !isPassthrough() && getXrPath(topLevelUserPath) == "/user/eyes_ext") {
-                CHECK_XRCMD(OpenXrApi::xrStringToPath(GetXrInstance(),
-                                                      "/interaction_profiles/ext/eye_gaze_interaction",
-                                                      &interactionProfile->interactionProfile));
+            if (isSessionHandled(session) && !isPassthrough() && topLevelUserPath == m_userEyesPath) {
+                interactionProfile->interactionProfile = m_eyeGazeInteractionProfilePath;
                 result = XR_SUCCESS;
             } else {
                 result = OpenXrApi::xrGetCurrentInteractionProfile(session, topLevelUserPath, interactionProfile);
@@ -619,16 +906,14 @@ namespace openxr_api_layer {
                               TLXArg(enumerateInfo->action, "Action"),
                               TLArg(sourceCapacityInput, "SourceCapacityInput"));
 
-            std::unique_lock lock(m_actionsAndSpacesMutex);
-
             XrResult result = XR_ERROR_RUNTIME_FAILURE;
-            if (isSessionHandled(session) && !isPassthrough() && m_eyeGazeActions.count(enumerateInfo->action)) {
+            if (isSessionHandled(session) && !isPassthrough() && isEyeGazeAction(enumerateInfo->action)) {
                 // TODO: Support the notion of (in)active actionsets and actionset priority.
                 *sourceCountOutput = 1;
                 result = XR_SUCCESS;
 
                 if (sourceCapacityInput) {
-                    CHECK_XRCMD(xrStringToPath(GetXrInstance(), "/user/eyes_ext/input/gaze_ext/pose", &sources[0]));
+                    sources[0] = m_gazePosePath;
                 }
             } else {
                 result = OpenXrApi::xrEnumerateBoundSourcesForAction(
@@ -670,8 +955,7 @@ namespace openxr_api_layer {
                               TLArg(getInfo->whichComponents, "WhichComponents"));
 
             XrResult result = XR_ERROR_RUNTIME_FAILURE;
-            const std::string& sourcePath = getXrPath(getInfo->sourcePath);
-            if (isSessionHandled(session) && !isPassthrough() && sourcePath == "/user/eyes_ext/input/gaze_ext/pose") {
+            if (isSessionHandled(session) && !isPassthrough() && getInfo->sourcePath == m_gazePosePath) {
                 std::string localizedName;
                 if ((getInfo->whichComponents & (XR_INPUT_SOURCE_LOCALIZED_NAME_INTERACTION_PROFILE_BIT |
                                                  XR_INPUT_SOURCE_LOCALIZED_NAME_COMPONENT_BIT)) ==
@@ -710,76 +994,311 @@ namespace openxr_api_layer {
         }
 
       private:
-        bool getEyeGaze(XrTime time, bool getStateOnly, XrVector3f& unitVector) {
-            bool result = false;
-            switch (m_trackerType) {
-            default:
-                if (m_tracker) {
-                    if (!getStateOnly) {
-                        result = m_tracker->getGaze(time, unitVector);
-                    } else {
-                        result = m_tracker->isGazeAvailable(time);
+        // All queries for the same time (typically within a frame) share a single query to the tracker.
+        bool getEyeGaze(XrTime time, XrQuaternionf& orientation, XrTime& sampleTime) {
+            std::unique_lock lock(m_gazeMutex);
+
+            pollTrackerProbe();
+            m_gazeQueries++;
+
+            const bool isCached = m_cachedGaze && m_cachedGaze->time == time;
+            if (!isCached) {
+                CachedGaze gaze{};
+                gaze.time = gaze.sampleTime = time;
+                switch (m_trackerType) {
+                default:
+                    if (m_tracker) {
+                        m_trackerQueries++;
+
+                        GazeSample sample;
+                        {
+                            const trace::ScopedSpan traceSpan("EyeTracker_GetGazeSample");
+                            gaze.isValid = m_tracker->getGazeSample(time, sample);
+                        }
+                        if (m_gazeRecorder) {
+                            m_gazeRecorder->record(time, gaze.isValid, sample);
+                        }
+                        if (gaze.isValid) {
+                            gaze.unitVector = sample.unitVector;
+                            gaze.orientation = sample.orientation;
+                            // XrEyeGazeSampleTimeEXT is the capture time, even when the pose is predicted, unless
+                            // configuration requests otherwise for applications that compensate for the latency.
+                            const bool isPredicted =
+                                predictEyeGaze(time, sample, gaze.unitVector, gaze.orientation);
+                            gaze.sampleTime = isPredicted && m_reportPredictedSampleTime ? time : sample.time;
+                        } else if (m_predictor) {
+                            m_predictor->reset();
+                        }
                     }
-                }
-                break;
+                    break;
 
-            case TrackerType::None:
-                break;
+                case TrackerType::None:
+                    break;
+                }
+                m_cachedGaze = gaze;
             }
 
+            const bool result = m_cachedGaze->isValid;
+            orientation = m_cachedGaze->orientation;
+            sampleTime = m_cachedGaze->sampleTime;
+
             TraceLoggingWrite(g_traceProvider,
                               "EyeGaze",
                               TLArg(result, "Valid"),
-                              TLArg(xr::ToString(unitVector).c_str(), "GazeUnitVector"));
+                              TLVector3fArg(m_cachedGaze->unitVector, "GazeUnitVector"),
+                              TLArg(sampleTime, "SampleTime"),
+                              TLArg(time - sampleTime, "SampleAge"),
+                              TLArg(isCached, "Cached"));
+            trace::Instant("EyeGaze",
+                           {{"Valid", (double)result},
+                            {"SampleAge", (double)(time - sampleTime)},
+                            {"Cached", (double)isCached}});
 
             return result;
         }
 
-        const std::string getXrPath(XrPath path) {
+        // Extrapolate a sample captured earlier than the requested time. Returns whether the gaze was extrapolated.
+        bool predictEyeGaze(XrTime time, const GazeSample& sample, XrVector3f& unitVector, XrQuaternionf& orientation) {
+            if (!m_predictor) {
+                return false;
+            }
+
+            if (sample.time > m_lastPredictorSampleTime) {
+                m_predictor->update(sample);
+                m_lastPredictorSampleTime = sample.time;
+            }
+
+            GazePrediction prediction;
+            if (sample.time < time && m_predictor->predict(time, prediction)) {
+                unitVector = prediction.unitVector;
+
+                // Rotate the sampled orientation along the predicted motion, to keep any roll from the tracker.
+                const XrQuaternionf motion =
+                    gaze::RotationBetween(gaze::Normalize(sample.unitVector), gaze::Normalize(unitVector));
+                orientation = gaze::Multiply(sample.orientation, motion);
+
+                TraceLoggingWrite(g_traceProvider,
+                                  "EyeGaze_Predict",
+                                  TLArg(time - sample.time, "Horizon"),
+                                  TLArg(prediction.uncertainty, "Uncertainty"));
+                return true;
+            }
+            return false;
+        }
+
+        // The gaze itself is reported without a velocity, so the velocity of another space relative to an eye gaze
+        // space is its velocity relative to the view, as if the gaze was still.
+        void locateVelocityInEyeGaze(XrSpace space,
+                                     XrTime time,
+                                     const XrQuaternionf& gazeOrientation,
+                                     const XrPosef& poseOffset,
+                                     XrSpaceVelocity& velocity) {
+            XrSpaceVelocity velocityInView{XR_TYPE_SPACE_VELOCITY};
+            XrSpaceLocation locationInView{XR_TYPE_SPACE_LOCATION, &velocityInView};
+            if (XR_FAILED(OpenXrApi::xrLocateSpace(space, m_viewSpace, time, &locationInView))) {
+                return;
+            }
+
+            const XrQuaternionf gazeInView = locateEyeGaze(gazeOrientation, poseOffset, Pose::Identity()).orientation;
+            velocity.velocityFlags = velocityInView.velocityFlags;
+            velocity.linearVelocity = gaze::InverseRotate(velocityInView.linearVelocity, gazeInView);
+            velocity.angularVelocity = gaze::InverseRotate(velocityInView.angularVelocity, gazeInView);
+        }
+
+        static XrPosef locateEyeGaze(const XrQuaternionf& gazeOrientation,
+                                     const XrPosef& poseOffset,
+                                     const XrPosef& viewPose) {
+            const XrPosef eyeGazeToView = Pose::MakePose(gazeOrientation, XrVector3f{0, 0, 0});
+            return Pose::Multiply(Pose::Multiply(eyeGazeToView, poseOffset), viewPose);
+        }
+
+        std::string getXrPath(XrPath path) {
             if (path == XR_NULL_PATH) {
                 return "";
             }
 
-            char buf[XR_MAX_PATH_LENGTH];
-            uint32_t count;
-            CHECK_XRCMD(OpenXrApi::xrPathToString(GetXrInstance(), path, sizeof(buf), &count, buf));
-            std::string str;
-            str.assign(buf, count - 1);
-            return str;
+            return m_pathCache.getString(path, [&](char* buffer, uint32_t capacity, uint32_t* count) {
+                return OpenXrApi::xrPathToString(GetXrInstance(), path, capacity, count, buffer);
+            });
         }
 
         bool isSystemHandled(XrSystemId systemId) const {
             return systemId == m_systemId;
         }
 
+        // Pick up the tracker selected by the background probes once they have settled, optionally waiting for them.
+        // There is no tracker (and no gaze) until then. Must be called with m_gazeMutex held.
+        void pollTrackerProbe(bool wait = false) {
+            if (!m_isProbingTracker.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            std::unique_lock lock(m_trackerProbeMutex);
+            if (!m_isProbingTracker || (!wait && !m_trackerProbe->isSettled())) {
+                return;
+            }
+
+            m_tracker = m_trackerProbe->getTracker();
+            m_isProbingTracker = false;
+
+            // Remember the outcome for the next time, unless it did not change. Not finding anything because a probe
+            // timed out is no reason to forget the cached tracker.
+            const auto found =
+                m_tracker ? std::make_optional(getTrackerType(m_tracker->getType())) : std::optional<std::string>{};
+            if (found != m_cachedTracker && (found || !m_trackerProbe->hasTimedOut())) {
+                saveCachedTracker(trackerCachePath(), m_trackerCacheKey, found);
+            }
+
+            setupTracker();
+            if (m_tracker && m_session != XR_NULL_HANDLE) {
+                startTracker();
+            }
+        }
+
+        // Must be called with m_gazeMutex held.
+        void startTracker() {
+            m_tracker->start(m_session);
+
+            // Configuration may request recording the gaze samples for offline analysis.
+            if (utilities::RegGetDword(HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "RecordGaze")
+                    .value_or(false)) {
+                const auto recordings = localAppData / "recordings";
+                CreateDirectoryA(recordings.string().c_str(), nullptr);
+
+                char name[64];
+                const std::time_t now = std::time(nullptr);
+                std::strftime(name, sizeof(name), "gaze-%Y%m%d-%H%M%S.bin", std::localtime(&now));
+
+                m_gazeRecorder = createGazeRecorder(recordings / name, m_trackerType);
+                if (m_gazeRecorder) {
+                    Log(fmt::format("Recording gaze to {}\n", (recordings / name).string()));
+                }
+            }
+        }
+
+        static std::filesystem::path trackerCachePath() {
+            return localAppData / "tracker-cache.txt";
+        }
+
+        void setupTracker() {
+            if (m_tracker) {
+                m_trackerType = m_tracker->getType();
+                Log(fmt::format("Using eye tracking: {}\n", getTrackerType(m_trackerType)));
+
+                // Configuration may request sampling the tracker from a background thread.
+                const uint32_t nativeRate = getTrackerNativeRate(m_trackerType);
+                if (nativeRate && utilities::RegGetDword(
+                                      HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "PollTracker")
+                                      .value_or(false)) {
+                    const uint32_t pollingRate =
+                        utilities::RegGetDword(
+                            HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "PollingRate")
+                            .value_or(nativeRate);
+                    const uint64_t affinityMask = static_cast<uint32_t>(
+                        utilities::RegGetDword(
+                            HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "PollingAffinity")
+                            .value_or(0));
+                    m_tracker =
+                        createPollingEyeTracker(*this, std::move(m_tracker), pollingRate, affinityMask);
+                }
+
+                // Configuration may request prediction of the gaze to the requested time.
+                m_predictor.reset();
+                switch ((PredictorType)utilities::RegGetDword(
+                            HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "GazePrediction")
+                            .value_or(0)) {
+                case PredictorType::ConstantVelocity:
+                    m_predictor = createConstantVelocityPredictor();
+                    break;
+                case PredictorType::Kalman:
+                    m_predictor = createKalmanPredictor();
+                    break;
+                default:
+                    break;
+                }
+                if (m_predictor) {
+                    Log(fmt::format("Using gaze prediction: {}\n", getPredictorType(m_predictor->getType())));
+                    m_reportPredictedSampleTime =
+                        utilities::RegGetDword(
+                            HKEY_LOCAL_MACHINE, "SOFTWARE\\OpenXR-Eye-Trackers", "ReportPredictedSampleTime")
+                            .value_or(false);
+                }
+            }
+            TraceLoggingWrite(g_traceProvider, "xrGetSystem", TLArg((int)m_trackerType, "TrackerType"));
+            if (m_trackerType == TrackerType::None) {
+                Log("No supported eye tracking device found\n");
+            }
+        }
+
         bool isSessionHandled(XrSession session) const {
             return session == m_session;
         }
 
         bool isPassthrough() const {
-            return m_trackerType == TrackerType::EyeGazeInteraction;
+            return m_isPassthrough;
         }
 
-        struct ActionSpace {
-            XrAction action;
-            XrPosef pose;
+        // Publish a modified registry, along with whether it holds any eye gaze space at all.
+        template <typename Update>
+        void updateActionsAndSpaces(Update&& update) {
+            m_actionsAndSpaces.update([&](ActionsAndSpaces& actionsAndSpaces) {
+                update(actionsAndSpaces);
+                actionsAndSpaces.updateEyeGazeSpaces();
+                m_hasEyeGazeSpaces.store(!actionsAndSpaces.eyeGazeSpaces.empty(), std::memory_order_release);
+            });
+        }
 
-            std::optional<bool> isEyeGaze;
+        bool isEyeGazeAction(XrAction action) const {
+            return !!m_actionsAndSpaces.read()->eyeGazeActions.count(action);
+        }
+
+        struct CachedGaze {
+            XrTime time;
+            bool isValid;
+            XrVector3f unitVector;
+            XrQuaternionf orientation;
+            XrTime sampleTime;
         };
 
         bool m_bypassApiLayer{false};
         XrSystemId m_systemId{XR_NULL_SYSTEM_ID};
         XrSession m_session{XR_NULL_HANDLE};
         XrSpace m_viewSpace{XR_NULL_HANDLE};
+
+        utils::general::XrPathCache m_pathCache;
+        XrPath m_eyeGazeInteractionProfilePath{XR_NULL_PATH};
+        XrPath m_userEyesPath{XR_NULL_PATH};
+        XrPath m_gazePath{XR_NULL_PATH};
+        XrPath m_gazePosePath{XR_NULL_PATH};
         std::unique_ptr<IEyeTracker> m_tracker{};
+        std::mutex m_trackerProbeMutex;
+        // Declared after m_tracker so that the probes are joined before any tracker is destroyed.
+        std::unique_ptr<ITrackerProbe> m_trackerProbe;
+        std::atomic<bool> m_isProbingTracker{false};
+        std::string m_runtimeName;
+        std::string m_trackerCacheKey;
+        std::optional<std::string> m_cachedTracker;
+        // Only changes outside of xrGetSystem() when a probed tracker is picked up, under m_gazeMutex.
         TrackerType m_trackerType{TrackerType::None};
+        bool m_isPassthrough{false};
+        std::unique_ptr<IGazePredictor> m_predictor{};
+        XrTime m_lastPredictorSampleTime{0};
+        bool m_reportPredictedSampleTime{false};
+
+        // Serializes queries to the tracker and the predictor.
+        std::mutex m_gazeMutex;
+        std::optional<CachedGaze> m_cachedGaze;
+        uint64_t m_gazeQueries{0};
+        uint64_t m_trackerQueries{0};
+        std::unique_ptr<IGazeRecorder> m_gazeRecorder;
 
         XrTime m_lastFrameBegunTime{};
         XrTime m_lastFrameWaitedTime{};
 
-        std::mutex m_actionsAndSpacesMutex;
-        std::unordered_set<XrAction> m_eyeGazeActions;
-        std::unordered_map<XrSpace, ActionSpace> m_actionSpaces;
+        RcuValue<ActionsAndSpaces> m_actionsAndSpaces;
+        // Lets locating spaces skip the registry entirely while the application has no eye gaze space, which is the
+        // common case for the many spaces located every frame.
+        std::atomic<bool> m_hasEyeGazeSpaces{false};
     };
 
     // This method is required by the framework to instantiate your OpenXrApi implementation.
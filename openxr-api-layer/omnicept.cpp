@@ -34,7 +34,7 @@ namespace openxr_api_layer {
     using namespace HP::Omnicept;
 
     struct OmniceptEyeTracker : IEyeTracker {
-        OmniceptEyeTracker() {
+        OmniceptEyeTracker(OpenXrApi& openXrApi) : m_clock(openXrApi) {
             if (!utilities::IsServiceRunning("HP Omnicept")) {
                 TraceLoggingWrite(g_traceProvider, "OmniceptEyeTracker_NoService");
                 throw EyeTrackerNotSupportedException();
@@ -112,7 +112,7 @@ namespace openxr_api_layer {
             return true;
         }
 
-        bool getGaze(XrTime time, XrVector3f& unitVector) override {
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
             Client::LastValueCached<Abi::EyeTracking> lvc;
             try {
                 lvc = m_omniceptClient->getLastData<Abi::EyeTracking>();
@@ -128,17 +128,25 @@ namespace openxr_api_layer {
             if (!lvc.valid || lvc.data.combinedGazeConfidence < 0.5f) {
                 return false;
             }
-            TraceLoggingWrite(
-                g_traceProvider,
-                "OmniceptEyeTracker_GetLastData",
-                TLArg(
-                    xr::ToString(XrVector3f{lvc.data.combinedGaze.x, lvc.data.combinedGaze.y, lvc.data.combinedGaze.z})
-                        .c_str(),
-                    "CombinedGaze"));
-
-            unitVector.x = -lvc.data.combinedGaze.x;
-            unitVector.y = lvc.data.combinedGaze.y;
-            unitVector.z = -lvc.data.combinedGaze.z;
+            TraceLoggingWrite(g_traceProvider,
+                              "OmniceptEyeTracker_GetLastData",
+                              TLVector3fArg(lvc.data.combinedGaze, "CombinedGaze"));
+
+            // The Omnicept timestamps are microseconds of the system clock.
+            m_clock.sync([] {
+                return (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+            });
+            const XrTime captureTime = m_clock.trackerTimeToXrTime(lvc.data.timestamp.systemTimeMicroSeconds * 1'000);
+            sample.time = captureTime ? captureTime : time;
+            sample.unitVector.x = -lvc.data.combinedGaze.x;
+            sample.unitVector.y = lvc.data.combinedGaze.y;
+            sample.unitVector.z = -lvc.data.combinedGaze.z;
+            sample.eyeUnitVector[xr::StereoView::Left] = sample.eyeUnitVector[xr::StereoView::Right] =
+                sample.unitVector;
+            sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+            sample.isValid = true;
 
             return true;
         }
@@ -147,12 +155,14 @@ namespace openxr_api_layer {
             return TrackerType::Omnicept;
         }
 
+        TrackerClock m_clock;
+
         std::unique_ptr<Client> m_omniceptClient;
     };
 
-    std::unique_ptr<IEyeTracker> createOmniceptEyeTracker() {
+    std::unique_ptr<IEyeTracker> createOmniceptEyeTracker(OpenXrApi& openXrApi) {
         try {
-            return std::make_unique<OmniceptEyeTracker>();
+            return std::make_unique<OmniceptEyeTracker>(openXrApi);
         } catch (EyeTrackerNotSupportedException&) {
             return {};
         }
@@ -30,7 +30,11 @@
 
 // Standard library.
 #include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstring>
 #include <ctime>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -38,15 +42,19 @@
 #include <iomanip>
 #include <iostream>
 #include <mutex>
+#include <shared_mutex>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <memory>
 #include <optional>
 #include <map>
+#include <thread>
 #include <unordered_set>
 #include <unordered_map>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -33,7 +33,7 @@ namespace openxr_api_layer {
     using namespace log;
 
     struct PimaxEyeTracker : IEyeTracker {
-        PimaxEyeTracker() {
+        PimaxEyeTracker(OpenXrApi& openXrApi) : m_clock(openXrApi) {
             pvrResult result = pvr_initialise(&m_pvr);
             if (result != pvr_success) {
                 TraceLoggingWrite(g_traceProvider, "PimaxEyeTracker_InitError", TLArg((int)result, "Error"));
@@ -93,10 +93,14 @@ namespace openxr_api_layer {
             return true;
         }
 
-        bool getGaze(XrTime time, XrVector3f& unitVector) override {
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
+            m_clock.sync([&] { return (int64_t)(pvr_getTimeSeconds(m_pvr) * 1e9); });
+
+            // Query the tracker at the requested time, expressed with the Pimax clock.
+            const int64_t absTime = m_clock.xrTimeToTrackerTime(time);
             pvrEyeTrackingInfo state{};
-            // TODO: Properly convert and use XrTime.
-            pvrResult result = pvr_getEyeTrackingInfo(m_pvrSession, pvr_getTimeSeconds(m_pvr), &state);
+            pvrResult result =
+                pvr_getEyeTrackingInfo(m_pvrSession, absTime ? absTime / 1e9 : pvr_getTimeSeconds(m_pvr), &state);
             if (result != pvr_success) {
                 TraceLoggingWrite(
                     g_traceProvider, "PimaxEyeTracker_GetEyeTrackingInfo_Error", TLArg((int)result, "Error"));
@@ -111,27 +115,21 @@ namespace openxr_api_layer {
             }
             TraceLoggingWrite(g_traceProvider,
                               "PimaxEyeTracker_GetEyeTrackingInfo",
-                              TLArg(xr::ToString(XrVector2f{state.GazeTan[xr::StereoView::Left].x,
-                                                            state.GazeTan[xr::StereoView::Left].y})
-                                        .c_str(),
-                                    "LeftGaze"),
-                              TLArg(xr::ToString(XrVector2f{state.GazeTan[xr::StereoView::Right].x,
-                                                            state.GazeTan[xr::StereoView::Right].y})
-                                        .c_str(),
-                                    "RightGaze"));
-
-            // Compute the gaze pitch/yaw angles by averaging both eyes.
-            const float angleHorizontal =
-                atan((state.GazeTan[xr::StereoView::Left].x + state.GazeTan[xr::StereoView::Right].x) / 2.f);
-            const float angleVertical =
-                atan((state.GazeTan[xr::StereoView::Left].y + state.GazeTan[xr::StereoView::Right].y) / 2.f);
+                              TLVector2fArg(state.GazeTan[xr::StereoView::Left], "LeftGaze"),
+                              TLVector2fArg(state.GazeTan[xr::StereoView::Right], "RightGaze"));
 
-            // Use polar coordinates to create a unit vector.
-            unitVector = {
-                sin(angleHorizontal) * cos(angleVertical),
-                sin(angleVertical),
-                -cos(angleHorizontal) * cos(angleVertical),
-            };
+            const XrTime captureTime = m_clock.trackerTimeToXrTime((int64_t)(state.TimeInSeconds * 1e9));
+            sample.time = captureTime ? captureTime : time;
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                sample.eyeUnitVector[eye] = gazeTanToUnitVector(state.GazeTan[eye].x, state.GazeTan[eye].y);
+            }
+
+            // Compute the combined gaze by averaging both eyes.
+            sample.unitVector = gazeTanToUnitVector(
+                (state.GazeTan[xr::StereoView::Left].x + state.GazeTan[xr::StereoView::Right].x) / 2.f,
+                (state.GazeTan[xr::StereoView::Left].y + state.GazeTan[xr::StereoView::Right].y) / 2.f);
+            sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+            sample.isValid = true;
 
             return true;
         }
@@ -140,13 +138,27 @@ namespace openxr_api_layer {
             return TrackerType::Pimax;
         }
 
+        static XrVector3f gazeTanToUnitVector(float tanHorizontal, float tanVertical) {
+            const float angleHorizontal = atan(tanHorizontal);
+            const float angleVertical = atan(tanVertical);
+
+            // Use polar coordinates to create a unit vector.
+            return {
+                sin(angleHorizontal) * cos(angleVertical),
+                sin(angleVertical),
+                -cos(angleHorizontal) * cos(angleVertical),
+            };
+        }
+
+        TrackerClock m_clock;
+
         pvrEnvHandle m_pvr{nullptr};
         pvrSessionHandle m_pvrSession{nullptr};
     };
 
-    std::unique_ptr<IEyeTracker> createPimaxEyeTracker() {
+    std::unique_ptr<IEyeTracker> createPimaxEyeTracker(OpenXrApi& openXrApi) {
         try {
-            return std::make_unique<PimaxEyeTracker>();
+            return std::make_unique<PimaxEyeTracker>(openXrApi);
         } catch (EyeTrackerNotSupportedException&) {
             return {};
         }
@@ -0,0 +1,164 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "utils.h"
+#include <log.h>
+#include <util.h>
+
+#include "trackers.h"
+
+namespace openxr_api_layer {
+
+    using namespace log;
+
+    // Wraps an eye tracker in order to sample it from a dedicated thread at a fixed rate. Queries from the application
+    // are answered from the gaze history and never call into the vendor SDK.
+    struct PollingEyeTracker : IEyeTracker {
+        PollingEyeTracker(OpenXrApi& openXrApi,
+                          std::unique_ptr<IEyeTracker> tracker,
+                          uint32_t pollingRate,
+                          uint64_t affinityMask)
+            : m_clock(openXrApi), m_tracker(std::move(tracker)), m_pollingRate(std::max(pollingRate, 1u)),
+              m_affinityMask(affinityMask) {
+        }
+
+        ~PollingEyeTracker() override {
+            stopPolling();
+        }
+
+        void start(XrSession session) override {
+            m_tracker->start(session);
+
+            stopPolling();
+            m_history.clear();
+            m_lastSampleTime = 0;
+            m_stopPolling = false;
+            m_pollingThread = std::thread([&]() { pollingThread(); });
+        }
+
+        void stop() override {
+            stopPolling();
+            m_tracker->stop();
+        }
+
+        bool isGazeAvailable(XrTime time) const override {
+            GazeSample sample;
+            return m_history.latest(sample) && sample.isValid;
+        }
+
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
+            return m_history.sample(time, sample) && sample.isValid;
+        }
+
+        TrackerType getType() const override {
+            return m_tracker->getType();
+        }
+
+        void pollingThread() {
+            TraceLoggingWrite(g_traceProvider,
+                              "PollingEyeTracker_Start",
+                              TLArg(m_pollingRate, "PollingRate"),
+                              TLArg(m_affinityMask, "AffinityMask"));
+
+            if (m_affinityMask) {
+                SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)m_affinityMask);
+            }
+            SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST);
+
+            // The default timer resolution is too coarse for the rates of eye trackers.
+            wil::unique_handle timer(
+                CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS));
+            const LONGLONG period = 10'000'000 / m_pollingRate;
+
+            while (!m_stopPolling) {
+                poll();
+
+                LARGE_INTEGER dueTime;
+                dueTime.QuadPart = -period;
+                if (timer && SetWaitableTimer(timer.get(), &dueTime, 0, nullptr, nullptr, false)) {
+                    WaitForSingleObject(timer.get(), INFINITE);
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(period / 10));
+                }
+            }
+
+            TraceLoggingWrite(g_traceProvider, "PollingEyeTracker_Stop");
+        }
+
+        void poll() {
+            m_clock.sync();
+            const XrTime now = m_clock.now();
+
+            GazeSample sample;
+            bool isValid = false;
+            try {
+                isValid = m_tracker->getGazeSample(now, sample);
+            } catch (std::exception& exc) {
+                TraceLoggingWrite(g_traceProvider, "PollingEyeTracker_Poll_Error", TLArg(exc.what(), "Error"));
+            }
+            if (!isValid) {
+                sample = {};
+                sample.time = now;
+            }
+
+            // Trackers polled faster than they produce samples return the same sample several times.
+            if (sample.time > m_lastSampleTime) {
+                m_history.push(sample);
+                m_lastSampleTime = sample.time;
+            }
+        }
+
+        void stopPolling() {
+            if (m_pollingThread.joinable()) {
+                m_stopPolling = true;
+                m_pollingThread.join();
+            }
+        }
+
+        TrackerClock m_clock;
+        const std::unique_ptr<IEyeTracker> m_tracker;
+        const uint32_t m_pollingRate;
+        const uint64_t m_affinityMask;
+
+        std::thread m_pollingThread;
+        std::atomic<bool> m_stopPolling{false};
+        GazeHistory<> m_history;
+        XrTime m_lastSampleTime{0};
+    };
+
+    std::unique_ptr<IEyeTracker> createPollingEyeTracker(OpenXrApi& openXrApi,
+                                                         std::unique_ptr<IEyeTracker> tracker,
+                                                         uint32_t pollingRate,
+                                                         uint64_t affinityMask) {
+        // Polling requires timestamping samples.
+        if (!canConvertQpcToXrTime(openXrApi)) {
+            Log("Cannot poll eye tracker without XR_KHR_win32_convert_performance_counter_time\n");
+            return tracker;
+        }
+
+        Log(fmt::format("Polling eye tracker at {} Hz\n", pollingRate));
+        return std::make_unique<PollingEyeTracker>(openXrApi, std::move(tracker), pollingRate, affinityMask);
+    }
+
+} // namespace openxr_api_layer
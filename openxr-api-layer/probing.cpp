@@ -0,0 +1,250 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "utils.h"
+#include <log.h>
+
+#include "trackers.h"
+
+namespace openxr_api_layer {
+
+    using namespace log;
+
+    // Each candidate is probed from its own thread. Probes cannot be cancelled: once the winner is chosen, the trackers
+    // of the candidates that complete later are simply destroyed.
+    // A preferred candidate is probed along with the candidates of higher priority, and the candidates of lower priority
+    // are only probed if it was not found. This way, the preferred candidate never shadows a higher-priority one.
+    struct TrackerProbe : ITrackerProbe {
+        TrackerProbe(std::vector<TrackerCandidate> candidates,
+                     std::chrono::milliseconds timeout,
+                     const std::string& preferred)
+            : m_timeout(timeout), m_startTime(std::chrono::steady_clock::now()), m_deadline(m_startTime + timeout),
+              m_probes(candidates.size()) {
+            const auto it = std::find_if(candidates.begin(), candidates.end(), [&](const TrackerCandidate& candidate) {
+                return candidate.name == preferred;
+            });
+            if (it != candidates.end()) {
+                m_preferred = it - candidates.begin();
+            }
+
+            for (size_t i = 0; i < candidates.size(); i++) {
+                m_probes[i].name = candidates[i].name;
+                m_threads.emplace_back([this, i, create = std::move(candidates[i].create)]() { probe(i, create); });
+            }
+        }
+
+        ~TrackerProbe() override {
+            // The probes may still use the OpenXR instance and the vendor SDKs.
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        bool isSettled() override {
+            std::unique_lock lock(m_mutex);
+            if (m_isResolved) {
+                return true;
+            }
+
+            // Mirror getTracker(): the outcome is known once a candidate was found and all the candidates before it
+            // are done, or once the deadline has passed.
+            for (const auto& probe : m_probes) {
+                if (probe.tracker) {
+                    return true;
+                }
+                if (!probe.isDone) {
+                    return std::chrono::steady_clock::now() >= m_deadline;
+                }
+            }
+            return true;
+        }
+
+        bool hasTimedOut() override {
+            std::unique_lock lock(m_mutex);
+            return m_hasTimedOut;
+        }
+
+        std::unique_ptr<IEyeTracker> getTracker() override {
+            std::unique_ptr<IEyeTracker> winner;
+            std::vector<std::unique_ptr<IEyeTracker>> losers;
+            {
+                std::unique_lock lock(m_mutex);
+                if (m_isResolved) {
+                    return {};
+                }
+
+                const auto waitStart = std::chrono::steady_clock::now();
+                for (auto& probe : m_probes) {
+                    // The deadline moves if the preferred candidate was not found.
+                    while (!winner && !probe.isDone && std::chrono::steady_clock::now() < m_deadline) {
+                        m_cv.wait_until(lock, m_deadline);
+                    }
+                    if (!winner && probe.tracker) {
+                        winner = std::move(probe.tracker);
+                        Log(fmt::format("Tracker probing chose {} (waited {} ms)\n",
+                                        probe.name,
+                                        ToMilliseconds(std::chrono::steady_clock::now() - waitStart)));
+                    } else if (probe.tracker) {
+                        losers.push_back(std::move(probe.tracker));
+                    } else if (!winner && !probe.isDone) {
+                        Log(fmt::format("Tracker probe for {} timed out\n", probe.name));
+                        m_hasTimedOut = true;
+                    }
+                }
+                m_isResolved = true;
+            }
+            m_cv.notify_all();
+
+            return winner;
+        }
+
+      private:
+        struct Probe {
+            std::string name;
+            bool isDone{false};
+            std::unique_ptr<IEyeTracker> tracker;
+        };
+
+        static long long ToMilliseconds(std::chrono::steady_clock::duration duration) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+        }
+
+        void probe(size_t index, const std::function<std::unique_ptr<IEyeTracker>()>& create) {
+            if (m_preferred && index > *m_preferred) {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [&] { return m_probes[*m_preferred].isDone || m_isResolved; });
+                if (m_probes[*m_preferred].tracker || m_isResolved) {
+                    m_probes[index].isDone = true;
+                    return;
+                }
+            }
+
+            TraceLocalActivity(local);
+            TraceLoggingWriteStart(local, "TrackerProbe", TLArg(m_probes[index].name.c_str(), "Name"));
+
+            const auto start = std::chrono::steady_clock::now();
+            std::unique_ptr<IEyeTracker> tracker;
+            try {
+                tracker = create();
+            } catch (std::exception& exc) {
+                ErrorLog(fmt::format("Tracker probe for {} failed: {}\n", m_probes[index].name, exc.what()));
+            }
+            const auto end = std::chrono::steady_clock::now();
+
+            TraceLoggingWriteStop(local, "TrackerProbe", TLArg(!!tracker, "Found"));
+            Log(fmt::format("Tracker probe for {}: {} in {} ms (started after {} ms)\n",
+                            m_probes[index].name,
+                            tracker ? "found" : "not found",
+                            ToMilliseconds(end - start),
+                            ToMilliseconds(start - m_startTime)));
+
+            {
+                std::unique_lock lock(m_mutex);
+                if (!m_isResolved) {
+                    m_probes[index].tracker = std::move(tracker);
+                } else {
+                    // The SDK kept running past the timeout. Its tracker is destroyed when we return.
+                    Log(fmt::format("Tracker probe for {} completed after the tracker was chosen, result discarded\n",
+                                    m_probes[index].name));
+                }
+                m_probes[index].isDone = true;
+                if (m_preferred && index == *m_preferred && !m_probes[index].tracker) {
+                    // Give the lower-priority candidates the full timeout.
+                    m_deadline = std::max(m_deadline, end + m_timeout);
+                }
+            }
+            m_cv.notify_all();
+        }
+
+        const std::chrono::milliseconds m_timeout;
+        const std::chrono::steady_clock::time_point m_startTime;
+        std::chrono::steady_clock::time_point m_deadline;
+        std::optional<size_t> m_preferred;
+
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::vector<Probe> m_probes;
+        bool m_isResolved{false};
+        bool m_hasTimedOut{false};
+
+        std::vector<std::thread> m_threads;
+    };
+
+    std::unique_ptr<ITrackerProbe> createTrackerProbe(std::vector<TrackerCandidate> candidates,
+                                                      std::chrono::milliseconds timeout,
+                                                      const std::string& preferred) {
+        return std::make_unique<TrackerProbe>(std::move(candidates), timeout, preferred);
+    }
+
+    // The cache is a text file with one "<key>\t<tracker>" entry per line.
+    std::optional<std::string> loadCachedTracker(const std::filesystem::path& path, const std::string& key) {
+        std::ifstream file(path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.rfind(key + '\t', 0) == 0) {
+                return line.substr(key.size() + 1);
+            }
+        }
+        return {};
+    }
+
+    void saveCachedTracker(const std::filesystem::path& path,
+                           const std::string& key,
+                           const std::optional<std::string>& tracker) {
+        std::vector<std::string> entries;
+        {
+            std::ifstream file(path);
+            std::string line;
+            while (std::getline(file, line)) {
+                if (line.rfind(key + '\t', 0) != 0) {
+                    entries.push_back(line);
+                }
+            }
+        }
+        if (tracker) {
+            entries.push_back(key + '\t' + *tracker);
+        }
+
+        // Another process may be reading the cache, so replace it in one go.
+        auto temporary = path;
+        temporary += fmt::format(".{}", GetCurrentProcessId());
+        {
+            std::ofstream file(temporary, std::ios_base::trunc);
+            for (const auto& entry : entries) {
+                file << entry << '\n';
+            }
+            if (!file) {
+                ErrorLog(fmt::format("Failed to write {}\n", temporary.string()));
+                return;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            ErrorLog(fmt::format("Failed to update {}: {}\n", path.string(), error.message()));
+            std::filesystem::remove(temporary, error);
+        }
+    }
+
+} // namespace openxr_api_layer
@@ -74,7 +74,7 @@ namespace openxr_api_layer {
             return true;
         }
 
-        bool getGaze(XrTime time, XrVector3f& unitVector) override {
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
             XrEyeGazesInfoFB eyeGazeInfo{XR_TYPE_EYE_GAZES_INFO_FB};
             eyeGazeInfo.baseSpace = m_viewSpace;
             eyeGazeInfo.time = time;
@@ -95,19 +95,23 @@ namespace openxr_api_layer {
                   eyeGaze.gaze[xr::StereoView::Right].gazeConfidence > 0.5f)) {
                 return false;
             }
-            TraceLoggingWrite(
-                g_traceProvider,
-                "EyeTrackerFB",
-                TLArg(xr::ToString(eyeGaze.gaze[xr::StereoView::Left].gazePose).c_str(), "LeftGazePose"),
-                TLArg(xr::ToString(eyeGaze.gaze[xr::StereoView::Right].gazePose).c_str(), "RightGazePose"));
+            TraceLoggingWrite(g_traceProvider,
+                              "EyeTrackerFB",
+                              TLPosefArg(eyeGaze.gaze[xr::StereoView::Left].gazePose, "LeftGazePose"),
+                              TLPosefArg(eyeGaze.gaze[xr::StereoView::Right].gazePose, "RightGazePose"));
 
-            // Average the poses from both eyes.
-            const auto gaze = xr::math::LoadXrPose(xr::math::Pose::Slerp(
-                eyeGaze.gaze[xr::StereoView::Left].gazePose, eyeGaze.gaze[xr::StereoView::Right].gazePose, 0.5f));
-            const auto gazeProjectedPoint = DirectX::XMVector3Transform(DirectX::XMVectorSet(0.f, 0.f, -1.f, 1.f), gaze);
+            // The runtime tells us when the sample was captured.
+            sample.time = eyeGaze.time;
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                sample.eyeUnitVector[eye] = getForward(eyeGaze.gaze[eye].gazePose);
+            }
 
-            unitVector = xr::math::Normalize(
-                {gazeProjectedPoint.m128_f32[0], gazeProjectedPoint.m128_f32[1], gazeProjectedPoint.m128_f32[2]});
+            // Average the poses from both eyes.
+            const XrPosef combinedGaze = xr::math::Pose::Slerp(
+                eyeGaze.gaze[xr::StereoView::Left].gazePose, eyeGaze.gaze[xr::StereoView::Right].gazePose, 0.5f);
+            sample.unitVector = getForward(combinedGaze);
+            sample.orientation = combinedGaze.orientation;
+            sample.isValid = true;
 
             return true;
         }
@@ -116,6 +120,13 @@ namespace openxr_api_layer {
             return TrackerType::QuestPro;
         }
 
+        static XrVector3f getForward(const XrPosef& pose) {
+            // The point one unit down -Z, transformed by the pose.
+            const XrVector3f forward = gaze::Rotate({0.f, 0.f, -1.f}, pose.orientation);
+            return gaze::Normalize(
+                {forward.x + pose.position.x, forward.y + pose.position.y, forward.z + pose.position.z});
+        }
+
         OpenXrApi& m_openXrApi;
         XrEyeTrackerFB m_eyeTracker{XR_NULL_HANDLE};
         XrSpace m_viewSpace{XR_NULL_HANDLE};
@@ -0,0 +1,78 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "pch.h"
+
+#include "utils.h"
+#include <log.h>
+
+#include "trackers.h"
+#include "gaze_recording.h"
+#include <gaze_replay.h>
+
+namespace openxr_api_layer {
+
+    using namespace log;
+
+    struct ReplayEyeTracker : IEyeTracker {
+        ReplayEyeTracker(std::vector<RecordedGaze> records, bool isRealTime) : m_replay(std::move(records), isRealTime) {
+        }
+
+        void start(XrSession session) override {
+            m_replay.restart();
+        }
+
+        void stop() override {
+        }
+
+        bool isGazeAvailable(XrTime time) const override {
+            return true;
+        }
+
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
+            return m_replay.getGazeSample(time, sample);
+        }
+
+        TrackerType getType() const override {
+            return TrackerType::Replay;
+        }
+
+        GazeReplay m_replay;
+    };
+
+    std::unique_ptr<IEyeTracker> createReplayEyeTracker(const std::filesystem::path& path, bool isRealTime) {
+        std::vector<RecordedGaze> records;
+        TrackerType recordedType;
+        if (!readGazeRecording(path, records, recordedType) || records.empty()) {
+            ErrorLog(fmt::format("Failed to read gaze recording {}\n", path.string()));
+            return {};
+        }
+
+        Log(fmt::format("Replaying {} gaze samples from {} ({}, {})\n",
+                        records.size(),
+                        path.string(),
+                        getTrackerType(recordedType),
+                        isRealTime ? "real time" : "as fast as possible"));
+        return std::make_unique<ReplayEyeTracker>(std::move(records), isRealTime);
+    }
+
+} // namespace openxr_api_layer
@@ -24,8 +24,10 @@
 
 #include "utils.h"
 #include <log.h>
+#include <trace.h>
 
 #include "trackers.h"
+#include <gaze_trajectory.h>
 
 namespace openxr_api_layer {
 
@@ -45,7 +47,7 @@ namespace openxr_api_layer {
             return true;
         }
 
-        bool getGaze(XrTime time, XrVector3f& unitVector) override {
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
             RECT rect;
             rect.left = 1;
             rect.right = 999;
@@ -57,7 +59,12 @@ namespace openxr_api_layer {
             GetCursorPos(&cursor);
 
             XrVector2f point = {(float)cursor.x / 1000.f, (float)cursor.y / 1000.f};
-            unitVector = xr::math::Normalize({point.x - 0.5f, 0.5f - point.y, -0.35f});
+            sample.time = time;
+            sample.unitVector = xr::math::Normalize({point.x - 0.5f, 0.5f - point.y, -0.35f});
+            sample.eyeUnitVector[xr::StereoView::Left] = sample.eyeUnitVector[xr::StereoView::Right] =
+                sample.unitVector;
+            sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+            sample.isValid = true;
 
             return true;
         }
@@ -67,8 +74,44 @@ namespace openxr_api_layer {
         }
     };
 
+    // A headless source of physiologically plausible gaze, for testing. Samples are reported with a fixed latency, and
+    // the true gaze at the requested time is traced as ground truth for the predictors.
+    struct SyntheticEyeTracker : IEyeTracker {
+        SyntheticEyeTracker(uint64_t seed, XrDuration latency) : m_gaze(seed, latency) {
+        }
+
+        void start(XrSession session) override {
+        }
+
+        void stop() override {
+        }
+
+        bool isGazeAvailable(XrTime time) const override {
+            return true;
+        }
+
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
+            const XrVector3f trueGaze = m_gaze.getTrueGaze(time);
+            TraceLoggingWrite(g_traceProvider, "SyntheticEyeTracker", TLVector3fArg(trueGaze, "TrueGaze"));
+            trace::Instant("SyntheticEyeTracker",
+                           {{"TrueGazeX", trueGaze.x}, {"TrueGazeY", trueGaze.y}, {"TrueGazeZ", trueGaze.z}});
+
+            return m_gaze.getGazeSample(time, sample);
+        }
+
+        TrackerType getType() const override {
+            return TrackerType::Simulated;
+        }
+
+        SyntheticGaze m_gaze;
+    };
+
     std::unique_ptr<IEyeTracker> createSimulatedEyeTracker() {
         return std::make_unique<SimulatedEyeTracker>();
     }
 
+    std::unique_ptr<IEyeTracker> createSyntheticEyeTracker(uint64_t seed, XrDuration latency) {
+        return std::make_unique<SyntheticEyeTracker>(seed, latency);
+    }
+
 } // namespace openxr_api_layer
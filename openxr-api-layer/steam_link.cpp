@@ -27,19 +27,19 @@
 #include <util.h>
 
 #include "trackers.h"
+#include <osc.h>
 
-#include <osc/OscReceivedElements.h>
-#include <osc/OscPacketListener.h>
 #include <ip/UdpSocket.h>
 
 namespace openxr_api_layer {
 
     using namespace log;
 
-    struct SteamLinkEyeTracker : IEyeTracker, osc::OscPacketListener {
+    struct SteamLinkEyeTracker : IEyeTracker, PacketListener {
         // Steam Link allow us to choose between port 9000 (labeled VRChat) and 9015 ("custom"). We put ourselves under
         // "custom".
-        SteamLinkEyeTracker() : m_socket(IpEndpointName(IpEndpointName::ANY_ADDRESS, 9015), this) {
+        SteamLinkEyeTracker(OpenXrApi& openXrApi)
+            : m_clock(openXrApi), m_socket(IpEndpointName(IpEndpointName::ANY_ADDRESS, 9015), this) {
         }
 
         ~SteamLinkEyeTracker() override {
@@ -58,20 +58,24 @@ namespace openxr_api_layer {
         }
 
         bool isGazeAvailable(XrTime time) const override {
-            const auto now = std::chrono::high_resolution_clock::now();
-            {
-                std::unique_lock lock(m_mutex);
-                return (now - m_lastReceivedTime).count() < 1'000'000'000;
-            }
+            const auto now = std::chrono::steady_clock::now();
+            return (now - m_latest.load().receivedTime) < std::chrono::seconds(1);
         }
 
-        bool getGaze(XrTime time, XrVector3f& unitVector) override {
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
             if (!isGazeAvailable(time)) {
                 return false;
             }
 
-            std::unique_lock lock(m_mutex);
-            unitVector = m_latestGaze;
+            if (m_clock.canConvertTime()) {
+                if (!m_history.sample(time, sample)) {
+                    return false;
+                }
+            } else {
+                // Without timestamps, we can only use the latest sample.
+                sample = m_latest.load().sample;
+                sample.time = time;
+            }
             return true;
         }
 
@@ -79,41 +83,65 @@ namespace openxr_api_layer {
             return TrackerType::SteamLink;
         }
 
-        void ProcessMessage(const osc::ReceivedMessage& m, const IpEndpointName& remoteEndpoint) override {
-            try {
-                if (std::string_view(m.AddressPattern()) == "/sl/eyeTrackedGazePoint") {
-                    const auto now = std::chrono::high_resolution_clock::now();
+        void ProcessPacket(const char* data, int size, const IpEndpointName& remoteEndpoint) override {
+            const auto now = std::chrono::steady_clock::now();
+            LARGE_INTEGER qpc;
+            QueryPerformanceCounter(&qpc);
 
-                    osc::ReceivedMessageArgumentStream args = m.ArgumentStream();
-                    XrVector3f gaze{};
-                    args >> gaze.x >> gaze.y >> gaze.z >> osc::EndMessage;
+            const bool isWellFormed = osc::ParsePacket(data, (size_t)size, [&](const osc::Message& m) {
+                if (m.address != "/sl/eyeTrackedGazePoint") {
+                    return;
+                }
 
+                float values[3];
+                if (!m.getFloats(values, 3)) {
                     TraceLoggingWrite(g_traceProvider,
-                                      "SteamLinkEyeTracker_ProcessMessage",
-                                      TLArg(xr::ToString(gaze).c_str(), "EyeTrackedGazePoint"));
-
-                    if (!(std::isnan(gaze.x) || std::isnan(gaze.y) || std::isnan(gaze.z))) {
-                        std::unique_lock lock(m_mutex);
-                        m_latestGaze = gaze;
-                        m_lastReceivedTime = now;
-                    }
+                                      "SteamLinkEyeTracker_ProcessPacket",
+                                      TLArg("Unexpected arguments", "Error"));
+                    return;
                 }
-            } catch (osc::Exception& e) {
-                TraceLoggingWrite(g_traceProvider, "SteamLinkEyeTracker_ProcessMessage", TLArg(e.what(), "Error"));
+                const XrVector3f gaze{values[0], values[1], values[2]};
+
+                TraceLoggingWrite(
+                    g_traceProvider, "SteamLinkEyeTracker_ProcessPacket", TLVector3fArg(gaze, "EyeTrackedGazePoint"));
+
+                if (!(std::isnan(gaze.x) || std::isnan(gaze.y) || std::isnan(gaze.z))) {
+                    GazeSample sample;
+                    m_clock.sync();
+                    sample.time = m_clock.qpcToXrTime(qpc.QuadPart);
+                    sample.unitVector = gaze;
+                    sample.eyeUnitVector[xr::StereoView::Left] = sample.eyeUnitVector[xr::StereoView::Right] =
+                        sample.unitVector;
+                    sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+                    sample.isValid = true;
+                    m_history.push(sample);
+                    m_latest.store({sample, now});
+                }
+            });
+            if (!isWellFormed) {
+                TraceLoggingWrite(
+                    g_traceProvider, "SteamLinkEyeTracker_ProcessPacket", TLArg("Malformed packet", "Error"));
             }
         }
 
+        TrackerClock m_clock;
+
         bool m_started{false};
         std::thread m_listeningThread;
         UdpListeningReceiveSocket m_socket;
-        mutable std::mutex m_mutex;
-        XrVector3f m_latestGaze{};
-        std::chrono::high_resolution_clock::time_point m_lastReceivedTime{};
+
+        // Written only by the listening thread.
+        GazeHistory<> m_history;
+        struct ReceivedGaze {
+            GazeSample sample;
+            std::chrono::steady_clock::time_point receivedTime;
+        };
+        SeqLock<ReceivedGaze> m_latest;
     };
 
-    std::unique_ptr<IEyeTracker> createSteamLinkEyeTracker() {
+    std::unique_ptr<IEyeTracker> createSteamLinkEyeTracker(OpenXrApi& openXrApi) {
         try {
-            return std::make_unique<SteamLinkEyeTracker>();
+            return std::make_unique<SteamLinkEyeTracker>(openXrApi);
         } catch (...) {
             return {};
         }
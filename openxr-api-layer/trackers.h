@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <clock_sync.h>
+#include <gaze_history.h>
+
 namespace openxr_api_layer {
 
     struct EyeTrackerNotSupportedException : public std::exception {
@@ -43,6 +46,7 @@ namespace openxr_api_layer {
         VirtualDesktop,
         SteamLink,
         OpenXr,
+        Replay,
     };
 
     static inline std::string getTrackerType(TrackerType type) {
@@ -69,28 +73,204 @@ namespace openxr_api_layer {
             return "Steam Link";
         case TrackerType::OpenXr:
             return "OpenXR";
+        case TrackerType::Replay:
+            return "Replay";
         }
         return "<Unknown>";
     }
 
+    // The rate at which trackers that must be queried produce new samples (Hz), or 0 if they are not meant to be
+    // polled.
+    static inline uint32_t getTrackerNativeRate(TrackerType type) {
+        switch (type) {
+#ifdef _WIN64
+        case TrackerType::Omnicept:
+            return 120;
+#endif
+        case TrackerType::Varjo:
+            return 200;
+        case TrackerType::Pimax:
+            return 120;
+        default:
+            return 0;
+        }
+    }
+
     struct IEyeTracker {
         virtual ~IEyeTracker() = default;
 
         virtual void start(XrSession session) = 0;
         virtual void stop() = 0;
         virtual bool isGazeAvailable(XrTime time) const = 0;
-        virtual bool getGaze(XrTime time, XrVector3f& unitVector) = 0;
+
+        // Retrieve the gaze along with the time it was captured. Trackers that cannot tell when a sample was captured
+        // report the requested time.
+        virtual bool getGazeSample(XrTime time, GazeSample& sample) = 0;
+
         virtual TrackerType getType() const = 0;
     };
 
+    static inline bool canConvertQpcToXrTime(const OpenXrApi& openXrApi) {
+        const auto& extensions = openXrApi.GetGrantedExtensions();
+        return std::find(extensions.cbegin(),
+                         extensions.cend(),
+                         XR_KHR_WIN32_CONVERT_PERFORMANCE_COUNTER_TIME_EXTENSION_NAME) != extensions.cend();
+    }
+
+    // Convert timestamps between a tracker's own clock, QueryPerformanceCounter() and XrTime. Each pair of clocks is
+    // correlated with periodic readings, so that converting a timestamp calls neither into the runtime nor the tracker
+    // SDK.
+    class TrackerClock {
+      public:
+        TrackerClock(OpenXrApi& openXrApi)
+            : m_openXrApi(openXrApi), m_canConvertTime(canConvertQpcToXrTime(openXrApi)) {
+            LARGE_INTEGER frequency;
+            QueryPerformanceFrequency(&frequency);
+            m_qpcFrequency = frequency.QuadPart;
+        }
+
+        bool canConvertTime() const {
+            return m_canConvertTime;
+        }
+
+        // Correlate QueryPerformanceCounter() with XrTime, when a new reading is due.
+        void sync() {
+            if (!m_canConvertTime) {
+                return;
+            }
+
+            const int64_t qpcTime = qpcNow();
+            if (m_xrTime.needsSample(qpcTime)) {
+                LARGE_INTEGER counter;
+                counter.QuadPart = qpcTimeToCounter(qpcTime);
+                XrTime time = 0;
+                if (XR_SUCCEEDED(m_openXrApi.xrConvertWin32PerformanceCounterToTimeKHR(
+                        m_openXrApi.GetXrInstance(), &counter, &time))) {
+                    m_xrTime.addSample(qpcTime, time, qpcTime);
+                }
+            }
+        }
+
+        // Also correlate the tracker's clock, with readClock() returning the tracker's current time in nanoseconds.
+        template <typename ReadClock>
+        void sync(ReadClock&& readClock) {
+            sync();
+            if (!m_canConvertTime) {
+                return;
+            }
+
+            const int64_t before = qpcNow();
+            if (m_trackerClock.needsSample(before)) {
+                const int64_t trackerTime = readClock();
+                m_trackerClock.addSample(before, trackerTime, qpcNow());
+            }
+        }
+
+        // Conversions return 0 until the clocks could be correlated.
+        XrTime now() const {
+            return qpcTimeToXrTime(qpcNow());
+        }
+
+        XrTime qpcToXrTime(LONGLONG counter) const {
+            return qpcTimeToXrTime(counterToQpcTime(counter));
+        }
+
+        XrTime trackerTimeToXrTime(int64_t trackerTime) const {
+            if (!m_trackerClock.isValid()) {
+                return 0;
+            }
+            return qpcTimeToXrTime(m_trackerClock.toLocal(trackerTime));
+        }
+
+        int64_t xrTimeToTrackerTime(XrTime time) const {
+            if (!m_xrTime.isValid() || !m_trackerClock.isValid()) {
+                return 0;
+            }
+            return m_trackerClock.toRemote(m_xrTime.toLocal(time));
+        }
+
+      private:
+        XrTime qpcTimeToXrTime(int64_t qpcTime) const {
+            if (!m_xrTime.isValid()) {
+                return 0;
+            }
+            return m_xrTime.toRemote(qpcTime);
+        }
+
+        // QueryPerformanceCounter() in nanoseconds.
+        int64_t qpcNow() const {
+            LARGE_INTEGER counter;
+            QueryPerformanceCounter(&counter);
+            return counterToQpcTime(counter.QuadPart);
+        }
+
+        int64_t counterToQpcTime(LONGLONG counter) const {
+            return (counter / m_qpcFrequency) * 1'000'000'000 +
+                   (counter % m_qpcFrequency) * 1'000'000'000 / m_qpcFrequency;
+        }
+
+        LONGLONG qpcTimeToCounter(int64_t qpcTime) const {
+            return (qpcTime / 1'000'000'000) * m_qpcFrequency +
+                   (qpcTime % 1'000'000'000) * m_qpcFrequency / 1'000'000'000;
+        }
+
+        OpenXrApi& m_openXrApi;
+        const bool m_canConvertTime;
+        LONGLONG m_qpcFrequency{1};
+
+        // QueryPerformanceCounter() to XrTime.
+        ClockCorrelation m_xrTime;
+        // QueryPerformanceCounter() to the tracker's clock.
+        ClockCorrelation m_trackerClock;
+    };
+
     std::unique_ptr<IEyeTracker> createSimulatedEyeTracker();
+    std::unique_ptr<IEyeTracker> createSyntheticEyeTracker(uint64_t seed, XrDuration latency);
+    std::unique_ptr<IEyeTracker> createReplayEyeTracker(const std::filesystem::path& path, bool isRealTime);
 #ifdef _WIN64
-    std::unique_ptr<IEyeTracker> createOmniceptEyeTracker();
+    std::unique_ptr<IEyeTracker> createOmniceptEyeTracker(OpenXrApi& openXrApi);
 #endif
-    std::unique_ptr<IEyeTracker> createVarjoEyeTracker();
+    std::unique_ptr<IEyeTracker> createVarjoEyeTracker(OpenXrApi& openXrApi);
     std::unique_ptr<IEyeTracker> createQuestProEyeTracker(OpenXrApi& openXrApi);
-    std::unique_ptr<IEyeTracker> createPimaxEyeTracker();
+    std::unique_ptr<IEyeTracker> createPimaxEyeTracker(OpenXrApi& openXrApi);
     std::unique_ptr<IEyeTracker> createVirtualDesktopEyeTracker();
-    std::unique_ptr<IEyeTracker> createSteamLinkEyeTracker();
+    std::unique_ptr<IEyeTracker> createSteamLinkEyeTracker(OpenXrApi& openXrApi);
+
+    std::unique_ptr<IEyeTracker> createPollingEyeTracker(OpenXrApi& openXrApi,
+                                                         std::unique_ptr<IEyeTracker> tracker,
+                                                         uint32_t pollingRate,
+                                                         uint64_t affinityMask);
+
+    // Runs the probes of candidate trackers concurrently, in the background.
+    struct ITrackerProbe {
+        virtual ~ITrackerProbe() = default;
+
+        // Whether the outcome is known, ie: getTracker() would return without waiting.
+        virtual bool isSettled() = 0;
+
+        // Wait for the highest-priority candidate that was found. Candidates still probing after the timeout are
+        // ignored.
+        virtual std::unique_ptr<IEyeTracker> getTracker() = 0;
+
+        // Whether getTracker() ignored a candidate of higher priority than its result because it was still probing.
+        virtual bool hasTimedOut() = 0;
+    };
+
+    struct TrackerCandidate {
+        std::string name;
+        std::function<std::unique_ptr<IEyeTracker>()> create;
+    };
+
+    // Candidates are given by decreasing priority. The preferred candidate, if any, is probed along with the candidates
+    // of higher priority, ahead of the candidates of lower priority.
+    std::unique_ptr<ITrackerProbe> createTrackerProbe(std::vector<TrackerCandidate> candidates,
+                                                      std::chrono::milliseconds timeout,
+                                                      const std::string& preferred = {});
+
+    // Remember the last tracker found for a runtime and system. Saving no tracker forgets the entry.
+    std::optional<std::string> loadCachedTracker(const std::filesystem::path& path, const std::string& key);
+    void saveCachedTracker(const std::filesystem::path& path,
+                           const std::string& key,
+                           const std::optional<std::string>& tracker);
 
 } // namespace openxr_api_layer
@@ -42,6 +42,22 @@ namespace openxr_api_layer::utilities {
         return data;
     }
 
+    static std::optional<std::wstring> RegGetString(HKEY hKey, const std::string& subKey, const std::string& value) {
+        wchar_t data[MAX_PATH]{};
+        DWORD dataSize = sizeof(data);
+        LONG retCode = ::RegGetValue(hKey,
+                                     std::wstring(subKey.begin(), subKey.end()).c_str(),
+                                     std::wstring(value.begin(), value.end()).c_str(),
+                                     RRF_SUBKEY_WOW6464KEY | RRF_RT_REG_SZ,
+                                     nullptr,
+                                     data,
+                                     &dataSize);
+        if (retCode != ERROR_SUCCESS) {
+            return {};
+        }
+        return data;
+    }
+
     // https://stackoverflow.com/questions/7808085/how-to-get-the-status-of-a-service-programmatically-running-stopped
     static bool IsServiceRunning(const std::string& name) {
         SC_HANDLE theService, scm;
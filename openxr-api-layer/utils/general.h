@@ -69,4 +69,45 @@ namespace openxr_api_layer::utils::general {
         return {static_cast<LONG>(uv.x * quadPixelSize.width), static_cast<LONG>(uv.y * quadPixelSize.height)};
     }
 
+    // Interns the strings of XrPath, so that only the first conversion of a path calls into the runtime. Memory is
+    // bounded by forgetting the oldest path once the cache is full. Strings are returned by value, since an entry may
+    // be evicted by another thread as soon as the lock is released.
+    class XrPathCache {
+      public:
+        static constexpr size_t Capacity = 512;
+
+        // pathToString(buffer, capacity, count) must behave like xrPathToString().
+        template <typename PathToString>
+        std::string getString(XrPath path, PathToString&& pathToString) {
+            {
+                std::shared_lock lock(m_mutex);
+                const auto it = m_strings.find(path);
+                if (it != m_strings.cend()) {
+                    return it->second;
+                }
+            }
+
+            char buf[XR_MAX_PATH_LENGTH];
+            uint32_t count;
+            CHECK_XRCMD(pathToString(buf, (uint32_t)sizeof(buf), &count));
+            std::string str(buf, count - 1);
+
+            std::unique_lock lock(m_mutex);
+            if (m_strings.try_emplace(path, str).second) {
+                m_order.push_back(path);
+                if (m_order.size() > Capacity) {
+                    m_strings.erase(m_order.front());
+                    m_order.pop_front();
+                }
+            }
+            return str;
+        }
+
+      private:
+        std::shared_mutex m_mutex;
+        std::unordered_map<XrPath, std::string> m_strings;
+        // Insertion order, for eviction.
+        std::deque<XrPath> m_order;
+    };
+
 } // namespace openxr_api_layer::utils::general
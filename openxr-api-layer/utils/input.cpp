@@ -547,17 +547,14 @@ namespace {
             return result;
         }
 
-        const std::string getXrPath(XrPath path) {
+        std::string getXrPath(XrPath path) {
             if (path == XR_NULL_PATH) {
                 return "<null>";
             }
 
-            char buf[XR_MAX_PATH_LENGTH];
-            uint32_t count;
-            CHECK_XRCMD(xrPathToString(m_instance, path, sizeof(buf), &count, buf));
-            std::string str;
-            str.assign(buf, count - 1);
-            return str;
+            return m_pathCache.getString(path, [&](char* buffer, uint32_t capacity, uint32_t* count) {
+                return xrPathToString(m_instance, path, capacity, count, buffer);
+            });
         }
 
         const XrInstance m_instance;
@@ -588,6 +585,7 @@ namespace {
         PFN_xrApplyHapticFeedback xrApplyHapticFeedback{nullptr};
         PFN_xrStringToPath xrStringToPath{nullptr};
         PFN_xrPathToString xrPathToString{nullptr};
+        XrPathCache m_pathCache;
     };
 
     struct InputFrameworkFactory : IInputFrameworkFactory {
@@ -897,7 +895,7 @@ namespace {
             std::vector<XrActionSuggestedBinding> updatedBindings(chainSuggestedBindings.suggestedBindings,
                                                                   chainSuggestedBindings.suggestedBindings +
                                                                       chainSuggestedBindings.countSuggestedBindings);
-            const std::string& interationProfile = getXrPath(suggestedBindings->interactionProfile);
+            const std::string interationProfile = getXrPath(suggestedBindings->interactionProfile);
             TraceLoggingWriteTagged(local,
                                     "InputFrameworkFactory_SuggestInteractionProfileBindings",
                                     TLArg(interationProfile.c_str(), "InteractionProfile"));
@@ -1023,17 +1021,14 @@ namespace {
             return static_cast<InputFramework*>(getInputFramework(session))->xrSyncActions_subst(session, syncInfo);
         }
 
-        const std::string getXrPath(XrPath path) {
+        std::string getXrPath(XrPath path) {
             if (path == XR_NULL_PATH) {
                 return "<null>";
             }
 
-            char buf[XR_MAX_PATH_LENGTH];
-            uint32_t count;
-            CHECK_XRCMD(xrPathToString(m_instance, path, sizeof(buf), &count, buf));
-            std::string str;
-            str.assign(buf, count - 1);
-            return str;
+            return m_pathCache.getString(path, [&](char* buffer, uint32_t capacity, uint32_t* count) {
+                return xrPathToString(m_instance, path, capacity, count, buffer);
+            });
         }
 
         const XrInstance m_instance;
@@ -1054,6 +1049,7 @@ namespace {
         PFN_xrSuggestInteractionProfileBindings xrSuggestInteractionProfileBindings{nullptr};
         PFN_xrStringToPath xrStringToPath{nullptr};
         PFN_xrPathToString xrPathToString{nullptr};
+        XrPathCache m_pathCache;
         ForwardDispatch m_forwardDispatch;
         bool m_needPollEvent{true};
 
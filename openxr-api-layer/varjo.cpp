@@ -57,7 +57,7 @@ namespace openxr_api_layer {
     } // namespace
 
     struct VarjoEyeTracker : IEyeTracker {
-        VarjoEyeTracker() {
+        VarjoEyeTracker(OpenXrApi& openXrApi) : m_clock(openXrApi) {
             if (!varjo_IsAvailable()) {
                 TraceLoggingWrite(g_traceProvider, "VarjoEyeTracker_NotAvailable");
                 throw EyeTrackerNotSupportedException();
@@ -103,7 +103,9 @@ namespace openxr_api_layer {
             return true;
         }
 
-        bool getGaze(XrTime time, XrVector3f& unitVector) override {
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
+            m_clock.sync([&] { return varjo_GetCurrentTime(m_varjoSession); });
+
             const auto gaze = varjo_GetGaze(m_varjoSession);
             TraceLoggingWrite(g_traceProvider,
                               "VarjoEyeTracker_GetGaze",
@@ -115,20 +117,27 @@ namespace openxr_api_layer {
             }
             TraceLoggingWrite(g_traceProvider,
                               "VarjoEyeTracker_GetGaze",
-                              TLArg(xr::ToString(XrVector3f{(float)gaze.leftEye.forward[0],
-                                                            (float)gaze.leftEye.forward[1],
-                                                            (float)gaze.leftEye.forward[2]})
-                                        .c_str(),
-                                    "LeftForward"),
-                              TLArg(xr::ToString(XrVector3f{(float)gaze.rightEye.forward[0],
-                                                            (float)gaze.rightEye.forward[1],
-                                                            (float)gaze.rightEye.forward[2]})
-                                        .c_str(),
-                                    "RightForward"));
-
-            unitVector.x = (float)(gaze.leftEye.forward[0] + gaze.rightEye.forward[0]) / 2.f;
-            unitVector.y = (float)(gaze.leftEye.forward[1] + gaze.rightEye.forward[1]) / 2.f;
-            unitVector.z = (float)(gaze.leftEye.forward[2] + gaze.rightEye.forward[2]) / 2.f;
+                              TraceLoggingFloat64FixedArray(gaze.leftEye.forward, 3, "LeftForward"),
+                              TraceLoggingFloat64FixedArray(gaze.rightEye.forward, 3, "RightForward"));
+
+            const XrTime captureTime = m_clock.trackerTimeToXrTime(gaze.captureTime);
+            sample.time = captureTime ? captureTime : time;
+            sample.eyeUnitVector[xr::StereoView::Left] = {(float)gaze.leftEye.forward[0],
+                                                          (float)gaze.leftEye.forward[1],
+                                                          (float)gaze.leftEye.forward[2]};
+            sample.eyeUnitVector[xr::StereoView::Right] = {(float)gaze.rightEye.forward[0],
+                                                           (float)gaze.rightEye.forward[1],
+                                                           (float)gaze.rightEye.forward[2]};
+            sample.unitVector.x = (float)(gaze.leftEye.forward[0] + gaze.rightEye.forward[0]) / 2.f;
+            sample.unitVector.y = (float)(gaze.leftEye.forward[1] + gaze.rightEye.forward[1]) / 2.f;
+            sample.unitVector.z = (float)(gaze.leftEye.forward[2] + gaze.rightEye.forward[2]) / 2.f;
+            sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+            sample.isValid = true;
+
+            TraceLoggingWrite(g_traceProvider,
+                              "VarjoEyeTracker_GetGaze",
+                              TLArg(gaze.captureTime, "CaptureTime"),
+                              TLArg(sample.time, "SampleTime"));
 
             return true;
         }
@@ -137,12 +146,14 @@ namespace openxr_api_layer {
             return TrackerType::Varjo;
         }
 
+        TrackerClock m_clock;
+
         varjo_Session* m_varjoSession{nullptr};
     };
 
-    std::unique_ptr<IEyeTracker> createVarjoEyeTracker() {
+    std::unique_ptr<IEyeTracker> createVarjoEyeTracker(OpenXrApi& openXrApi) {
         try {
-            return std::make_unique<VarjoEyeTracker>();
+            return std::make_unique<VarjoEyeTracker>(openXrApi);
         } catch (EyeTrackerNotSupportedException&) {
             return {};
         }
@@ -62,68 +62,197 @@ namespace openxr_api_layer {
         }
 
         bool isGazeAvailable(XrTime time) const override {
+            EyeState state;
+            return readEyeState(state) && isEyeStateValid(state) && isUnitOrientation(state);
+        }
+
+        bool getGazeSample(XrTime time, GazeSample& sample) override {
+            // A torn state is usually implausible. Give Virtual Desktop a moment to complete its update and read again.
+            EyeState state;
+            const auto now = std::chrono::steady_clock::now();
+            for (uint32_t attempt = 0;; attempt++) {
+                if (!readEyeState(state) || !isEyeStateValid(state)) {
+                    return false;
+                }
+                if (isUnitOrientation(state) && isContinuous(state, now)) {
+                    break;
+                }
+                if (attempt + 1 == MaxPlausibilityAttempts) {
+                    TraceLoggingWrite(g_traceProvider, "VirtualDesktopEyeTracker_ImplausibleState");
+                    return false;
+                }
+                std::this_thread::sleep_for(RereadDelay);
+            }
+            m_lastAccepted = {state, now, true};
+
+            XrPosef eyeGaze[xr::StereoView::Count];
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                const Pose& pose = state.eyePose[eye];
+                eyeGaze[eye] = xr::math::Pose::MakePose(
+                    XrQuaternionf{pose.orientation.x, pose.orientation.y, pose.orientation.z, pose.orientation.w},
+                    XrVector3f{pose.position.x, pose.position.y, pose.position.z});
+            }
+
             TraceLoggingWrite(g_traceProvider,
                               "VirtualDesktopEyeTracker",
-                              TLArg(!!m_sharedState->LeftEyeIsValid, "LeftValid"),
-                              TLArg(m_sharedState->LeftEyeConfidence, "LeftConfidence"),
-                              TLArg(!!m_sharedState->RightEyeIsValid, "RightValid"),
-                              TLArg(m_sharedState->RightEyeConfidence, "RightConfidence"));
+                              TLPosefArg(eyeGaze[xr::StereoView::Left], "LeftGazePose"),
+                              TLPosefArg(eyeGaze[xr::StereoView::Right], "RightGazePose"));
 
-            if (!(m_sharedState->LeftEyeIsValid && m_sharedState->RightEyeIsValid)) {
-                return false;
-            }
-            if (!(m_sharedState->LeftEyeConfidence > 0.5f && m_sharedState->RightEyeConfidence > 0.5f)) {
-                return false;
+            // The shared state does not tell when the sample was captured.
+            sample.time = time;
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                sample.eyeUnitVector[eye] = getForward(eyeGaze[eye]);
             }
 
+            // Average the poses from both eyes.
+            const XrPosef combinedGaze =
+                xr::math::Pose::Slerp(eyeGaze[xr::StereoView::Left], eyeGaze[xr::StereoView::Right], 0.5f);
+            sample.unitVector = getForward(combinedGaze);
+            sample.orientation = combinedGaze.orientation;
+            sample.isValid = true;
+
             return true;
         }
 
-        bool getGaze(XrTime time, XrVector3f& unitVector) override {
-            if (!isGazeAvailable(time)) {
-                return false;
+        TrackerType getType() const override {
+            return TrackerType::VirtualDesktop;
+        }
+
+        static XrVector3f getForward(const XrPosef& pose) {
+            // The point one unit down -Z, transformed by the pose.
+            const XrVector3f forward = gaze::Rotate({0.f, 0.f, -1.f}, pose.orientation);
+            return gaze::Normalize(
+                {forward.x + pose.position.x, forward.y + pose.position.y, forward.z + pose.position.z});
+        }
+
+        // The eye fields of the shared state.
+        struct EyeState {
+            bool isValid[xr::StereoView::Count];
+            Pose eyePose[xr::StereoView::Count];
+            float confidence[xr::StereoView::Count];
+        };
+
+        // Virtual Desktop updates the shared state without any locking scheme. Copy the eye fields twice and only
+        // accept the copy when both agree. This rejects a copy that overlaps with a write in progress, but not the
+        // state left half-updated by a writer that was preempted: both copies then agree on the torn state. That case
+        // is left to the plausibility checks in getGazeSample().
+        bool readEyeState(EyeState& state) const {
+            static constexpr size_t Begin = offsetof(BodyStateV2, LeftEyeIsValid);
+            static constexpr size_t End = offsetof(BodyStateV2, RightEyeConfidence) + sizeof(float);
+            static constexpr uint32_t MaxReadAttempts = 8;
+
+            const volatile uint8_t* const source = reinterpret_cast<const volatile uint8_t*>(m_sharedState) + Begin;
+            uint8_t first[End - Begin];
+            uint8_t second[End - Begin];
+            for (uint32_t attempt = 0; attempt < MaxReadAttempts; attempt++) {
+                for (size_t i = 0; i < sizeof(first); i++) {
+                    first[i] = source[i];
+                }
+                for (size_t i = 0; i < sizeof(second); i++) {
+                    second[i] = source[i];
+                }
+                if (memcmp(first, second, sizeof(first))) {
+                    continue;
+                }
+
+                const auto field = [&](size_t offset, auto& value) {
+                    memcpy(&value, first + offset - Begin, sizeof(value));
+                };
+                uint8_t isValid;
+                field(offsetof(BodyStateV2, LeftEyeIsValid), isValid);
+                state.isValid[xr::StereoView::Left] = !!isValid;
+                field(offsetof(BodyStateV2, RightEyeIsValid), isValid);
+                state.isValid[xr::StereoView::Right] = !!isValid;
+                field(offsetof(BodyStateV2, LeftEyePose), state.eyePose[xr::StereoView::Left]);
+                field(offsetof(BodyStateV2, RightEyePose), state.eyePose[xr::StereoView::Right]);
+                field(offsetof(BodyStateV2, LeftEyeConfidence), state.confidence[xr::StereoView::Left]);
+                field(offsetof(BodyStateV2, RightEyeConfidence), state.confidence[xr::StereoView::Right]);
+                return true;
             }
 
-            // TODO: Any file locking scheme?
-            Pose leftEyePose = m_sharedState->LeftEyePose;
-            Pose rightEyePose = m_sharedState->RightEyePose;
-            XrPosef eyeGaze[] = {
-                xr::math::Pose::MakePose(
-                    XrQuaternionf{leftEyePose.orientation.x,
-                                  leftEyePose.orientation.y,
-                                  leftEyePose.orientation.z,
-                                  leftEyePose.orientation.w},
-                    XrVector3f{leftEyePose.position.x, leftEyePose.position.y, leftEyePose.position.z}),
-                xr::math::Pose::MakePose(
-                    XrQuaternionf{rightEyePose.orientation.x,
-                                  rightEyePose.orientation.y,
-                                  rightEyePose.orientation.z,
-                                  rightEyePose.orientation.w},
-                    XrVector3f{rightEyePose.position.x, rightEyePose.position.y, rightEyePose.position.z})};
+            TraceLoggingWrite(g_traceProvider, "VirtualDesktopEyeTracker_TornRead");
+            return false;
+        }
 
+        static bool isEyeStateValid(const EyeState& state) {
             TraceLoggingWrite(g_traceProvider,
                               "VirtualDesktopEyeTracker",
-                              TLArg(xr::ToString(eyeGaze[xr::StereoView::Left]).c_str(), "LeftGazePose"),
-                              TLArg(xr::ToString(eyeGaze[xr::StereoView::Right]).c_str(), "RightGazePose"));
+                              TLArg(state.isValid[xr::StereoView::Left], "LeftValid"),
+                              TLArg(state.confidence[xr::StereoView::Left], "LeftConfidence"),
+                              TLArg(state.isValid[xr::StereoView::Right], "RightValid"),
+                              TLArg(state.confidence[xr::StereoView::Right], "RightConfidence"));
 
-            // Average the poses from both eyes.
-            const auto gaze = xr::math::LoadXrPose(
-                xr::math::Pose::Slerp(eyeGaze[xr::StereoView::Left], eyeGaze[xr::StereoView::Right], 0.5f));
-            const auto gazeProjectedPoint =
-                DirectX::XMVector3Transform(DirectX::XMVectorSet(0.f, 0.f, -1.f, 1.f), gaze);
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                if (!state.isValid[eye] || !(state.confidence[eye] > 0.5f)) {
+                    return false;
+                }
+            }
 
-            unitVector = xr::math::Normalize(
-                {gazeProjectedPoint.m128_f32[0], gazeProjectedPoint.m128_f32[1], gazeProjectedPoint.m128_f32[2]});
+            return true;
+        }
 
+        // A pose that does not have a unit quaternion was likely mixed from two updates.
+        static bool isUnitOrientation(const EyeState& state) {
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                const auto& q = state.eyePose[eye].orientation;
+                const float lengthSquared = q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w;
+                if (!(std::abs(lengthSquared - 1.f) < 0.01f)) {
+                    return false;
+                }
+            }
             return true;
         }
 
-        TrackerType getType() const override {
-            return TrackerType::VirtualDesktop;
+        // The eyes cannot turn faster than a saccade, nor move within the head. After a while without an accepted
+        // state, anything goes, so that a genuine jump is not rejected forever.
+        bool isContinuous(const EyeState& state, std::chrono::steady_clock::time_point now) const {
+            if (!m_lastAccepted.isSet || now - m_lastAccepted.time > ContinuityWindow) {
+                return true;
+            }
+
+            const float elapsed = std::chrono::duration<float>(now - m_lastAccepted.time).count();
+            const float maxAngle = MaxAngularSpeed * elapsed + AngleSlack;
+            for (uint32_t eye = 0; eye < xr::StereoView::Count; eye++) {
+                const Pose& pose = state.eyePose[eye];
+                const Pose& last = m_lastAccepted.state.eyePose[eye];
+
+                const float dot = std::abs(pose.orientation.x * last.orientation.x +
+                                           pose.orientation.y * last.orientation.y +
+                                           pose.orientation.z * last.orientation.z +
+                                           pose.orientation.w * last.orientation.w);
+                const float angle = 2.f * std::acos(std::min(dot, 1.f));
+                if (!(angle <= maxAngle)) {
+                    return false;
+                }
+
+                const float dx = pose.position.x - last.position.x;
+                const float dy = pose.position.y - last.position.y;
+                const float dz = pose.position.z - last.position.z;
+                if (!(dx * dx + dy * dy + dz * dz <= MaxPositionJump * MaxPositionJump)) {
+                    return false;
+                }
+            }
+            return true;
         }
 
+        static constexpr uint32_t MaxPlausibilityAttempts = 3;
+        static constexpr std::chrono::microseconds RereadDelay{500};
+        static constexpr std::chrono::milliseconds ContinuityWindow{100};
+        // Saccades peak around 700 degrees per second.
+        static constexpr float MaxAngularSpeed = 1000.f * 3.14159265f / 180.f;
+        static constexpr float AngleSlack = 5.f * 3.14159265f / 180.f;
+        static constexpr float MaxPositionJump = 0.01f;
+
         wil::unique_handle m_faceStateFile;
         BodyStateV2* m_sharedState{nullptr};
+
+        // Only used by getGazeSample(), which is never called concurrently.
+        struct AcceptedState {
+            EyeState state;
+            std::chrono::steady_clock::time_point time;
+            bool isSet{false};
+        };
+        AcceptedState m_lastAccepted;
     };
 
     std::unique_ptr<IEyeTracker> createVirtualDesktopEyeTracker() {
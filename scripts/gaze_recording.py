@@ -0,0 +1,168 @@
+# MIT License
+#
+# Copyright(c) 2022-2023 Matthieu Bucchianeri
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this softwareand associated documentation files(the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions :
+#
+# The above copyright noticeand this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Read the gaze recordings written by the layer (see openxr-api-layer/gaze_recording.h).
+#
+# Usage:
+#   python gaze_recording.py csv <recording.bin> [output.csv]
+#   python gaze_recording.py stats <recording.bin>
+
+import csv
+import math
+import struct
+import sys
+
+MAGIC = b'XRGAZE\0\0'
+FILE_HEADER = struct.Struct('<8sII32s')
+CHUNK_HEADER = struct.Struct('<IIq')
+VECTOR = struct.Struct('<hhh')
+IS_VALID = 1 << 0
+
+
+class Record:
+    def __init__(self, query_time, is_valid, sample_time=None, combined=None, left=None, right=None):
+        self.query_time = query_time
+        self.is_valid = is_valid
+        self.sample_time = sample_time
+        self.combined = combined
+        self.left = left
+        self.right = right
+
+
+def read_varint(data, offset):
+    value = 0
+    shift = 0
+    while True:
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7f) << shift
+        if byte < 0x80:
+            return value, offset
+        shift += 7
+
+
+def unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def read_vector(data, offset):
+    return tuple(v / 32767 for v in VECTOR.unpack_from(data, offset)), offset + VECTOR.size
+
+
+def read_recording(path):
+    '''Returns the tracker type and the list of records.'''
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    magic, version, chunk_size, tracker_name = FILE_HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError(f'{path} is not a gaze recording')
+    if version != 2:
+        raise ValueError(f'Unsupported recording version {version}')
+
+    records = []
+    chunk = chunk_size
+    while chunk + CHUNK_HEADER.size <= len(data):
+        record_count, used_bytes, query_time = CHUNK_HEADER.unpack_from(data, chunk)
+        offset = chunk + CHUNK_HEADER.size
+        for _ in range(record_count):
+            delta, offset = read_varint(data, offset)
+            query_time += unzigzag(delta)
+            flags = data[offset]
+            offset += 1
+            if flags & IS_VALID:
+                age, offset = read_varint(data, offset)
+                combined, offset = read_vector(data, offset)
+                left, offset = read_vector(data, offset)
+                right, offset = read_vector(data, offset)
+                records.append(Record(query_time, True, query_time - unzigzag(age), combined, left, right))
+            else:
+                records.append(Record(query_time, False))
+        if offset != chunk + used_bytes:
+            raise ValueError(f'Corrupted chunk at offset {chunk}')
+        chunk += chunk_size
+
+    return tracker_name.split(b'\0', 1)[0].decode(), records
+
+
+def write_csv(records, out):
+    writer = csv.writer(out, lineterminator='\n')
+    writer.writerow(['QueryTime', 'Valid', 'SampleTime', 'SampleAgeMs', 'X', 'Y', 'Z', 'LeftX', 'LeftY', 'LeftZ',
+                     'RightX', 'RightY', 'RightZ'])
+    for r in records:
+        if r.is_valid:
+            writer.writerow([r.query_time, 1, r.sample_time, f'{(r.query_time - r.sample_time) / 1e6:.3f}'] +
+                            [f'{v:.5f}' for v in r.combined + r.left + r.right])
+        else:
+            writer.writerow([r.query_time, 0] + [''] * 11)
+
+
+def percentile(values, p):
+    if not values:
+        return float('nan')
+    values = sorted(values)
+    return values[min(len(values) - 1, int(p * len(values)))]
+
+
+def print_stats(tracker, records):
+    print(f'Tracker: {tracker}')
+    print(f'Queries: {len(records)}')
+    if not records:
+        return
+
+    valid = [r for r in records if r.is_valid]
+    duration = (records[-1].query_time - records[0].query_time) / 1e9
+    print(f'Duration: {duration:.1f} s')
+    print(f'Valid: {len(valid)} ({100 * len(valid) / len(records):.1f}%)')
+
+    intervals = [(b.query_time - a.query_time) / 1e6 for a, b in zip(records, records[1:])]
+    print(f'Query interval (ms): p50 {percentile(intervals, 0.5):.2f}, p99 {percentile(intervals, 0.99):.2f}')
+
+    ages = [(r.query_time - r.sample_time) / 1e6 for r in valid]
+    print(f'Sample age (ms): p50 {percentile(ages, 0.5):.2f}, p99 {percentile(ages, 0.99):.2f}, '
+          f'max {max(ages, default=float("nan")):.2f}')
+
+    # Angular distance between consecutive valid samples, as a measure of jitter and saccades.
+    steps = [math.degrees(math.acos(max(-1.0, min(1.0, sum(x * y for x, y in zip(a.combined, b.combined))))))
+             for a, b in zip(valid, valid[1:])]
+    print(f'Gaze step (deg): p50 {percentile(steps, 0.5):.3f}, p99 {percentile(steps, 0.99):.3f}')
+
+
+def main(argv):
+    if len(argv) < 3 or argv[1] not in ('csv', 'stats'):
+        print('Usage: gaze_recording.py csv|stats <recording.bin> [output.csv]')
+        return 1
+
+    tracker, records = read_recording(argv[2])
+    if argv[1] == 'csv':
+        if len(argv) > 3:
+            with open(argv[3], 'w') as out:
+                write_csv(records, out)
+        else:
+            write_csv(records, sys.stdout)
+    else:
+        print_stats(tracker, records)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
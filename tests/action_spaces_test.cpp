@@ -0,0 +1,90 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <action_spaces.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // OpenXR handles are pointers on 64-bit platforms and integers elsewhere.
+    template <typename Handle>
+    Handle MakeHandle(uint64_t value) {
+        if constexpr (std::is_pointer_v<Handle>) {
+            return reinterpret_cast<Handle>(static_cast<uintptr_t>(value));
+        } else {
+            return static_cast<Handle>(value);
+        }
+    }
+
+    XrPosef MakePose(float x) {
+        return {{0.f, 0.f, 0.f, 1.f}, {x, 0.f, 0.f}};
+    }
+
+} // namespace
+
+TEST(ActionsAndSpaces, FindsOnlyEyeGazeSpaces) {
+    const XrAction gazeAction = MakeHandle<XrAction>(1);
+    const XrAction otherAction = MakeHandle<XrAction>(2);
+    const XrSpace gazeSpace = MakeHandle<XrSpace>(10);
+    const XrSpace otherSpace = MakeHandle<XrSpace>(11);
+
+    ActionsAndSpaces actionsAndSpaces;
+    actionsAndSpaces.eyeGazeActions.insert(gazeAction);
+    actionsAndSpaces.actionSpaces.insert_or_assign(gazeSpace, ActionSpace{gazeAction, MakePose(1.f)});
+    actionsAndSpaces.actionSpaces.insert_or_assign(otherSpace, ActionSpace{otherAction, MakePose(2.f)});
+    actionsAndSpaces.updateEyeGazeSpaces();
+
+    ASSERT_EQ(actionsAndSpaces.eyeGazeSpaces.size(), 1u);
+
+    XrPosef pose{};
+    ASSERT_TRUE(actionsAndSpaces.findEyeGazeSpace(gazeSpace, pose));
+    EXPECT_EQ(pose.position.x, 1.f);
+    EXPECT_FALSE(actionsAndSpaces.findEyeGazeSpace(otherSpace, pose));
+    EXPECT_FALSE(actionsAndSpaces.findEyeGazeSpace(MakeHandle<XrSpace>(12), pose));
+}
+
+TEST(ActionsAndSpaces, FollowsBindingsMadeAfterTheSpaces) {
+    const XrAction action = MakeHandle<XrAction>(1);
+    const XrSpace space = MakeHandle<XrSpace>(10);
+
+    ActionsAndSpaces actionsAndSpaces;
+    actionsAndSpaces.actionSpaces.insert_or_assign(space, ActionSpace{action, MakePose(0.f)});
+    actionsAndSpaces.updateEyeGazeSpaces();
+
+    XrPosef pose;
+    EXPECT_FALSE(actionsAndSpaces.findEyeGazeSpace(space, pose));
+
+    actionsAndSpaces.eyeGazeActions.insert(action);
+    actionsAndSpaces.updateEyeGazeSpaces();
+    EXPECT_TRUE(actionsAndSpaces.findEyeGazeSpace(space, pose));
+
+    actionsAndSpaces.actionSpaces.erase(space);
+    actionsAndSpaces.updateEyeGazeSpaces();
+    EXPECT_FALSE(actionsAndSpaces.findEyeGazeSpace(space, pose));
+    EXPECT_TRUE(actionsAndSpaces.eyeGazeSpaces.empty());
+}
@@ -0,0 +1,156 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <clock_sync.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // A remote clock running with a fixed offset and drift relative to the local clock.
+    struct SyntheticClock {
+        int64_t offset;
+        double drift;
+
+        int64_t remoteAt(int64_t local) const {
+            return offset + local + (int64_t)std::llround((double)local * drift);
+        }
+    };
+
+    // Sample the remote clock whenever the correlation asks for it, for the given duration of local time. Each
+    // reading is bracketed by up to `maxBracket` nanoseconds, and the remote clock is read anywhere in the bracket.
+    void Feed(ClockCorrelation& correlation,
+              const SyntheticClock& clock,
+              int64_t start,
+              int64_t duration,
+              int64_t maxBracket,
+              std::mt19937& random) {
+        std::uniform_int_distribution<int64_t> bracket(0, maxBracket);
+        for (int64_t local = start; local < start + duration; local += 1'000'000) {
+            if (!correlation.needsSample(local)) {
+                continue;
+            }
+            const int64_t before = local;
+            const int64_t after = local + bracket(random);
+            std::uniform_int_distribution<int64_t> readAt(before, after);
+            correlation.addSample(before, clock.remoteAt(readAt(random)), after);
+        }
+    }
+
+} // namespace
+
+TEST(ClockCorrelation, IsInvalidUntilSampled) {
+    ClockCorrelation correlation;
+    EXPECT_FALSE(correlation.isValid());
+    EXPECT_TRUE(correlation.needsSample(0));
+
+    correlation.addSample(1000, 5000, 1000);
+    EXPECT_TRUE(correlation.isValid());
+    EXPECT_EQ(correlation.toRemote(2000), 6000);
+    EXPECT_EQ(correlation.toLocal(6000), 2000);
+
+    correlation.reset();
+    EXPECT_FALSE(correlation.isValid());
+    EXPECT_TRUE(correlation.needsSample(0));
+}
+
+TEST(ClockCorrelation, SamplesFastThenSlow) {
+    ClockCorrelation correlation;
+    int64_t local = 0;
+    for (size_t i = 0; i < ClockCorrelation::WindowSize - 1; i++) {
+        correlation.addSample(local, local, local);
+        EXPECT_FALSE(correlation.needsSample(local + ClockCorrelation::FastSamplingPeriod - 1));
+        EXPECT_TRUE(correlation.needsSample(local + ClockCorrelation::FastSamplingPeriod));
+        local += ClockCorrelation::FastSamplingPeriod;
+    }
+
+    // Once the window is full, only the drift needs following.
+    correlation.addSample(local, local, local);
+    EXPECT_FALSE(correlation.needsSample(local + ClockCorrelation::FastSamplingPeriod));
+    EXPECT_TRUE(correlation.needsSample(local + ClockCorrelation::SlowSamplingPeriod));
+}
+
+TEST(ClockCorrelation, FollowsOffsetAndDrift) {
+    std::mt19937 random(1234);
+    const SyntheticClock clock{-7'000'000'000'000, 150e-6};
+
+    ClockCorrelation correlation;
+    Feed(correlation, clock, 1'000'000'000, 30'000'000'000, 20'000, random);
+    ASSERT_TRUE(correlation.isValid());
+
+    // Converting a time shortly after the last sample, as the trackers do.
+    for (int64_t local = 31'000'000'000; local < 32'000'000'000; local += 100'000'000) {
+        EXPECT_LT(std::llabs(correlation.toRemote(local) - clock.remoteAt(local)), 20'000) << local;
+        EXPECT_LT(std::llabs(correlation.toLocal(clock.remoteAt(local)) - local), 20'000) << local;
+    }
+
+    // Without the drift, the same conversion would be off by 150us per second since the fit.
+    const int64_t later = 40'000'000'000;
+    EXPECT_LT(std::llabs(correlation.toRemote(later) - clock.remoteAt(later)), 100'000);
+}
+
+TEST(ClockCorrelation, ConversionsAreInverse) {
+    std::mt19937 random(42);
+    const SyntheticClock clock{123'456'789, -80e-6};
+
+    ClockCorrelation correlation;
+    Feed(correlation, clock, 0, 20'000'000'000, 10'000, random);
+
+    for (int64_t local = 0; local < 25'000'000'000; local += 1'234'567'891) {
+        EXPECT_LE(std::llabs(correlation.toLocal(correlation.toRemote(local)) - local), 1) << local;
+    }
+}
+
+TEST(ClockCorrelation, PrefersTightReadings) {
+    const SyntheticClock clock{1'000'000, 0.0};
+
+    ClockCorrelation correlation;
+    int64_t local = 0;
+    for (size_t i = 0; i < ClockCorrelation::WindowSize - 1; i++) {
+        correlation.addSample(local, clock.remoteAt(local + 500), local + 1'000);
+        local += ClockCorrelation::FastSamplingPeriod;
+    }
+
+    // A reading with a 10ms bracket, taken at the very end of it.
+    correlation.addSample(local, clock.remoteAt(local + 10'000'000), local + 10'000'000);
+
+    EXPECT_LT(std::llabs(correlation.toRemote(local) - clock.remoteAt(local)), 50'000);
+}
+
+TEST(ClockCorrelation, ClampsImplausibleDrift) {
+    const SyntheticClock clock{0, 10'000e-6};
+
+    ClockCorrelation correlation;
+    int64_t local = 0;
+    for (size_t i = 0; i < ClockCorrelation::WindowSize; i++) {
+        correlation.addSample(local, clock.remoteAt(local), local);
+        local += ClockCorrelation::FastSamplingPeriod;
+    }
+
+    const int64_t elapsed = correlation.toRemote(local + 1'000'000'000) - correlation.toRemote(local);
+    EXPECT_NEAR((double)elapsed, 1e9 * (1.0 + ClockCorrelation::MaxDrift), 10.0);
+}
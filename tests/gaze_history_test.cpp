@@ -0,0 +1,165 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <gaze_history.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // A gaze looking `yaw` radians to the left of -Z.
+    GazeSample MakeSample(XrTime time, float yaw, bool isValid = true) {
+        GazeSample sample;
+        sample.time = time;
+        sample.unitVector = {-std::sin(yaw), 0.f, -std::cos(yaw)};
+        for (uint32_t eye = 0; eye < EyeCount; eye++) {
+            sample.eyeUnitVector[eye] = sample.unitVector;
+        }
+        sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+        sample.isValid = isValid;
+        return sample;
+    }
+
+    float YawOf(const XrVector3f& unitVector) {
+        return std::atan2(-unitVector.x, -unitVector.z);
+    }
+
+} // namespace
+
+TEST(GazeHistory, IsEmptyInitially) {
+    GazeHistory<> history;
+    GazeSample sample;
+    EXPECT_FALSE(history.latest(sample));
+    EXPECT_FALSE(history.sample(0, sample));
+}
+
+TEST(GazeHistory, ReturnsTheLatestSample) {
+    GazeHistory<> history;
+    history.push(MakeSample(100, 0.1f));
+    history.push(MakeSample(200, 0.2f));
+
+    GazeSample sample;
+    ASSERT_TRUE(history.latest(sample));
+    EXPECT_EQ(sample.time, 200);
+    EXPECT_FLOAT_EQ(YawOf(sample.unitVector), 0.2f);
+
+    history.clear();
+    EXPECT_FALSE(history.latest(sample));
+}
+
+TEST(GazeHistory, InterpolatesBetweenSamples) {
+    GazeHistory<> history;
+    history.push(MakeSample(1000, 0.f));
+    history.push(MakeSample(2000, 0.2f));
+    history.push(MakeSample(3000, 0.4f));
+
+    GazeSample sample;
+    ASSERT_TRUE(history.sample(2500, sample));
+    EXPECT_EQ(sample.time, 2500);
+    EXPECT_TRUE(sample.isValid);
+    EXPECT_NEAR(YawOf(sample.unitVector), 0.3f, 1e-3f);
+    EXPECT_NEAR(YawOf(sample.eyeUnitVector[1]), 0.3f, 1e-3f);
+
+    // The orientation follows the same path.
+    const XrVector3f forward = gaze::Rotate({0.f, 0.f, -1.f}, sample.orientation);
+    EXPECT_NEAR(YawOf(forward), 0.3f, 1e-3f);
+
+    ASSERT_TRUE(history.sample(1000, sample));
+    EXPECT_NEAR(YawOf(sample.unitVector), 0.f, 1e-6f);
+}
+
+TEST(GazeHistory, ClampsOutsideOfTheHistory) {
+    GazeHistory<> history;
+    history.push(MakeSample(1000, 0.1f));
+    history.push(MakeSample(2000, 0.2f));
+
+    GazeSample sample;
+    ASSERT_TRUE(history.sample(5000, sample));
+    EXPECT_EQ(sample.time, 2000);
+
+    ASSERT_TRUE(history.sample(10, sample));
+    EXPECT_EQ(sample.time, 1000);
+}
+
+TEST(GazeHistory, PicksTheNearestSampleAroundAnInvalidOne) {
+    GazeHistory<> history;
+    history.push(MakeSample(1000, 0.1f));
+    history.push(MakeSample(2000, 0.f, false));
+
+    GazeSample sample;
+    ASSERT_TRUE(history.sample(1400, sample));
+    EXPECT_EQ(sample.time, 1000);
+    EXPECT_TRUE(sample.isValid);
+
+    ASSERT_TRUE(history.sample(1600, sample));
+    EXPECT_EQ(sample.time, 2000);
+    EXPECT_FALSE(sample.isValid);
+}
+
+TEST(GazeHistory, OnlyKeepsTheMostRecentSamples) {
+    GazeHistory<8> history;
+    for (XrTime time = 1; time <= 100; time++) {
+        history.push(MakeSample(time * 1000, time * 0.001f));
+    }
+
+    // One slot is left to the producer, so the oldest reachable sample is 7 behind the latest.
+    GazeSample sample;
+    ASSERT_TRUE(history.sample(0, sample));
+    EXPECT_EQ(sample.time, 94'000);
+
+    ASSERT_TRUE(history.sample(96'500, sample));
+    EXPECT_NEAR(YawOf(sample.unitVector), 0.0965f, 1e-4f);
+}
+
+TEST(GazeHistory, ReadersRaceWithTheProducer) {
+    GazeHistory<16> history;
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (XrTime time = 1; time <= 100'000; time++) {
+            history.push(MakeSample(time * 1000, std::fmod(time * 0.001f, 1.f)));
+        }
+        done.store(true);
+    });
+
+    while (!done.load()) {
+        GazeSample latest;
+        if (!history.latest(latest)) {
+            continue;
+        }
+        // The producer may have wrapped around past the requested time, in which case we get the oldest sample.
+        // Either way, we get a well-formed sample.
+        const XrTime time = latest.time - 2500;
+        GazeSample sample;
+        if (history.sample(time, sample)) {
+            EXPECT_TRUE(sample.time == time || sample.time % 1000 == 0) << sample.time;
+            EXPECT_NEAR(std::sqrt(gaze::Dot(sample.unitVector, sample.unitVector)), 1.f, 1e-4f);
+        }
+    }
+    producer.join();
+}
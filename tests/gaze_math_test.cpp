@@ -0,0 +1,178 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <gaze_math.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    constexpr float Pi = 3.14159265f;
+
+    ::testing::AssertionResult VectorNear(const XrVector3f& actual, const XrVector3f& expected, float tolerance) {
+        if (std::abs(actual.x - expected.x) > tolerance || std::abs(actual.y - expected.y) > tolerance ||
+            std::abs(actual.z - expected.z) > tolerance) {
+            return ::testing::AssertionFailure() << "(" << actual.x << ", " << actual.y << ", " << actual.z
+                                                 << ") != (" << expected.x << ", " << expected.y << ", "
+                                                 << expected.z << ")";
+        }
+        return ::testing::AssertionSuccess();
+    }
+
+    XrQuaternionf AxisAngle(const XrVector3f& axis, float angle) {
+        return {axis.x * std::sin(angle / 2), axis.y * std::sin(angle / 2), axis.z * std::sin(angle / 2),
+                std::cos(angle / 2)};
+    }
+
+    // The former gaze orientation, built from angles approximated by the tangent of the gaze coordinates, like
+    // XMQuaternionRotationRollPitchYaw(tan(y), -tan(x), 0).
+    XrQuaternionf RollPitchYawOrientation(const XrVector3f& unitVector) {
+        const XrQuaternionf pitch = AxisAngle({1.f, 0.f, 0.f}, std::tan(unitVector.y));
+        const XrQuaternionf yaw = AxisAngle({0.f, 1.f, 0.f}, -std::tan(unitVector.x));
+        return gaze::Multiply(pitch, yaw);
+    }
+
+    float AngleBetween(const XrVector3f& a, const XrVector3f& b) {
+        return std::acos(std::clamp(gaze::Dot(gaze::Normalize(a), gaze::Normalize(b)), -1.f, 1.f));
+    }
+
+    XrVector3f RandomUnitVector(std::mt19937& random) {
+        std::normal_distribution<float> normal;
+        return gaze::Normalize(XrVector3f{normal(random), normal(random), normal(random)});
+    }
+
+    const XrVector3f Forward{0.f, 0.f, -1.f};
+
+} // namespace
+
+TEST(GazeMath, MultiplyAppliesTheFirstRotationFirst) {
+    const XrQuaternionf a = AxisAngle({1.f, 0.f, 0.f}, Pi / 2);
+    const XrQuaternionf b = AxisAngle({0.f, 1.f, 0.f}, Pi / 2);
+
+    const XrVector3f v{0.f, 0.f, -1.f};
+    EXPECT_TRUE(VectorNear(gaze::Rotate(v, gaze::Multiply(a, b)), gaze::Rotate(gaze::Rotate(v, a), b), 1e-6f));
+    EXPECT_TRUE(VectorNear(gaze::Rotate(v, gaze::Multiply(a, b)), {0.f, 1.f, 0.f}, 1e-6f));
+}
+
+TEST(GazeMath, InverseRotateUndoesRotate) {
+    std::mt19937 random(7);
+    for (int i = 0; i < 100; i++) {
+        const XrVector3f axis = RandomUnitVector(random);
+        const XrQuaternionf q = AxisAngle(axis, 0.1f * i);
+        const XrVector3f v = RandomUnitVector(random);
+        EXPECT_TRUE(VectorNear(gaze::InverseRotate(gaze::Rotate(v, q), q), v, 1e-5f));
+    }
+}
+
+TEST(GazeMath, RotationBetweenMapsOneVectorOntoTheOther) {
+    std::mt19937 random(1);
+    for (int i = 0; i < 1000; i++) {
+        const XrVector3f from = RandomUnitVector(random);
+        const XrVector3f to = RandomUnitVector(random);
+        const XrQuaternionf q = gaze::RotationBetween(from, to);
+        EXPECT_NEAR(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w, 1.f, 1e-5f);
+        EXPECT_TRUE(VectorNear(gaze::Rotate(from, q), to, 1e-4f));
+    }
+}
+
+TEST(GazeMath, RotationBetweenOppositeVectors) {
+    for (const XrVector3f& from : {XrVector3f{1.f, 0.f, 0.f}, XrVector3f{0.f, 1.f, 0.f}, Forward}) {
+        const XrVector3f to{-from.x, -from.y, -from.z};
+        EXPECT_TRUE(VectorNear(gaze::Rotate(from, gaze::RotationBetween(from, to)), to, 1e-6f));
+    }
+}
+
+TEST(GazeMath, OrientationLooksDownTheGaze) {
+    std::mt19937 random(3);
+    for (int i = 0; i < 1000; i++) {
+        const XrVector3f gaze = RandomUnitVector(random);
+        EXPECT_TRUE(VectorNear(gaze::Rotate(Forward, gaze::OrientationFromUnitVector(gaze)), gaze, 1e-4f));
+    }
+
+    // Vectors that are not quite unit length are normalized.
+    EXPECT_TRUE(
+        VectorNear(gaze::Rotate(Forward, gaze::OrientationFromUnitVector({0.f, 0.f, -2.f})), Forward, 1e-6f));
+}
+
+TEST(GazeMath, OrientationIsMoreAccurateThanRollPitchYaw) {
+    // A gaze 30 degrees to the right and 20 degrees up, within the range of eye trackers.
+    const XrVector3f gaze = gaze::Normalize(XrVector3f{std::tan(30 * Pi / 180), std::tan(20 * Pi / 180), -1.f});
+
+    const float error = AngleBetween(gaze::Rotate(Forward, gaze::OrientationFromUnitVector(gaze)), gaze);
+    const float formerError = AngleBetween(gaze::Rotate(Forward, RollPitchYawOrientation(gaze)), gaze);
+    EXPECT_LT(error, 1e-3f * Pi / 180);
+    EXPECT_GT(formerError, 0.25f * Pi / 180);
+}
+
+TEST(GazeMath, OrientationStaysAccurateAcrossTheTrackingRange) {
+    // Sweep gazes up to 45 degrees off-axis in every direction.
+    float maxError = 0.f, maxFormerError = 0.f;
+    for (float yaw = -45.f; yaw <= 45.f; yaw += 5.f) {
+        for (float pitch = -45.f; pitch <= 45.f; pitch += 5.f) {
+            const XrVector3f gaze =
+                gaze::Normalize(XrVector3f{std::tan(yaw * Pi / 180), std::tan(pitch * Pi / 180), -1.f});
+            maxError =
+                std::max(maxError, AngleBetween(gaze::Rotate(Forward, gaze::OrientationFromUnitVector(gaze)), gaze));
+            maxFormerError =
+                std::max(maxFormerError, AngleBetween(gaze::Rotate(Forward, RollPitchYawOrientation(gaze)), gaze));
+        }
+    }
+
+    EXPECT_LT(maxError, 1e-3f * Pi / 180);
+    // The former construction is several degrees off in the corners of the range.
+    EXPECT_GT(maxFormerError, 5.f * Pi / 180);
+}
+
+TEST(GazeMath, SlerpFollowsTheShortestArc) {
+    const XrQuaternionf a = AxisAngle({0.f, 1.f, 0.f}, 0.f);
+    const XrQuaternionf b = AxisAngle({0.f, 1.f, 0.f}, Pi / 2);
+
+    EXPECT_TRUE(VectorNear(gaze::Rotate(Forward, gaze::Slerp(a, b, 0.f)), gaze::Rotate(Forward, a), 1e-6f));
+    EXPECT_TRUE(VectorNear(gaze::Rotate(Forward, gaze::Slerp(a, b, 1.f)), gaze::Rotate(Forward, b), 1e-6f));
+    EXPECT_NEAR(AngleBetween(gaze::Rotate(Forward, gaze::Slerp(a, b, 0.25f)), Forward), Pi / 8, 1e-5f);
+
+    // The same rotation as -b.
+    const XrQuaternionf negatedB{-b.x, -b.y, -b.z, -b.w};
+    EXPECT_NEAR(AngleBetween(gaze::Rotate(Forward, gaze::Slerp(a, negatedB, 0.5f)), Forward), Pi / 4, 1e-5f);
+
+    // Nearly identical orientations do not divide by zero.
+    const XrQuaternionf c = AxisAngle({0.f, 1.f, 0.f}, 1e-7f);
+    const XrQuaternionf q = gaze::Slerp(a, c, 0.5f);
+    EXPECT_FALSE(std::isnan(q.w));
+}
+
+TEST(GazeMath, NlerpStaysOnTheSphere) {
+    const XrVector3f a{1.f, 0.f, 0.f};
+    const XrVector3f b{0.f, 1.f, 0.f};
+    const XrVector3f mid = gaze::Nlerp(a, b, 0.5f);
+    EXPECT_NEAR(gaze::Dot(mid, mid), 1.f, 1e-6f);
+    EXPECT_NEAR(mid.x, mid.y, 1e-6f);
+
+    // Opposite vectors have no midpoint, we pick one of the ends.
+    EXPECT_TRUE(VectorNear(gaze::Nlerp(a, {-1.f, 0.f, 0.f}, 0.5f), {-1.f, 0.f, 0.f}, 0.f));
+}
@@ -0,0 +1,201 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gaze_recording_format.h>
+#include <gaze_replay.h>
+
+using namespace openxr_api_layer;
+using namespace openxr_api_layer::recording;
+
+namespace {
+
+    constexpr XrDuration Millisecond = 1'000'000;
+
+    GazeSample LookingAt(XrTime time, const XrVector3f& direction) {
+        GazeSample sample;
+        sample.time = time;
+        sample.unitVector = gaze::Normalize(direction);
+        sample.eyeUnitVector[0] = gaze::Normalize(XrVector3f{direction.x - 0.05f, direction.y, direction.z});
+        sample.eyeUnitVector[1] = gaze::Normalize(XrVector3f{direction.x + 0.05f, direction.y, direction.z});
+        sample.isValid = true;
+        return sample;
+    }
+
+    // Lay out a recording in memory the way the recorder does, with all the records in the first chunk.
+    class RecordingWriter {
+      public:
+        explicit RecordingWriter(const char* trackerName) : m_data(2 * ChunkSize) {
+            FileHeader header{};
+            memcpy(header.magic, Magic, sizeof(Magic));
+            header.version = Version;
+            header.chunkSize = ChunkSize;
+            strncpy(header.trackerName, trackerName, sizeof(header.trackerName) - 1);
+            memcpy(m_data.data(), &header, sizeof(header));
+        }
+
+        void record(XrTime queryTime, bool isValid, const GazeSample& sample = {}) {
+            ChunkHeader chunkHeader;
+            memcpy(&chunkHeader, m_data.data() + ChunkSize, sizeof(chunkHeader));
+            if (!chunkHeader.recordCount) {
+                chunkHeader.usedBytes = sizeof(ChunkHeader);
+                chunkHeader.baseTime = queryTime;
+                m_lastQueryTime = queryTime;
+            }
+
+            uint8_t* const start = m_data.data() + ChunkSize + chunkHeader.usedBytes;
+            uint8_t* const end = WriteRecord(start, m_lastQueryTime, queryTime, isValid, sample);
+            chunkHeader.usedBytes += (uint32_t)(end - start);
+            chunkHeader.recordCount++;
+            m_lastQueryTime = queryTime;
+            memcpy(m_data.data() + ChunkSize, &chunkHeader, sizeof(chunkHeader));
+        }
+
+        // The recorder trims the unused part of the last chunk.
+        std::vector<uint8_t> finish() const {
+            ChunkHeader chunkHeader;
+            memcpy(&chunkHeader, m_data.data() + ChunkSize, sizeof(chunkHeader));
+            return {m_data.begin(), m_data.begin() + ChunkSize + chunkHeader.usedBytes};
+        }
+
+      private:
+        std::vector<uint8_t> m_data;
+        XrTime m_lastQueryTime{0};
+    };
+
+    void ExpectNear(const XrVector3f& a, const XrVector3f& b) {
+        // Quantized to 1/32767.
+        EXPECT_NEAR(a.x, b.x, 1e-4f);
+        EXPECT_NEAR(a.y, b.y, 1e-4f);
+        EXPECT_NEAR(a.z, b.z, 1e-4f);
+    }
+
+} // namespace
+
+TEST(GazeRecording, RoundTripsRecords) {
+    RecordingWriter writer("Virtual Desktop");
+    const GazeSample first = LookingAt(1000 * Millisecond - 12 * Millisecond, {0.2f, -0.1f, -1.f});
+    const GazeSample third = LookingAt(1022 * Millisecond - 9 * Millisecond, {-0.3f, 0.25f, -1.f});
+    writer.record(1000 * Millisecond, true, first);
+    writer.record(1011 * Millisecond, false);
+    writer.record(1022 * Millisecond, true, third);
+    const auto data = writer.finish();
+
+    std::vector<RecordedGaze> records;
+    std::string trackerName;
+    ASSERT_TRUE(ParseRecording(data.data(), data.size(), records, trackerName));
+    EXPECT_EQ(trackerName, "Virtual Desktop");
+    ASSERT_EQ(records.size(), 3u);
+
+    EXPECT_EQ(records[0].queryTime, 1000 * Millisecond);
+    ASSERT_TRUE(records[0].isValid);
+    EXPECT_EQ(records[0].sample.time, first.time);
+    ExpectNear(records[0].sample.unitVector, first.unitVector);
+    ExpectNear(records[0].sample.eyeUnitVector[0], first.eyeUnitVector[0]);
+    ExpectNear(records[0].sample.eyeUnitVector[1], first.eyeUnitVector[1]);
+
+    EXPECT_EQ(records[1].queryTime, 1011 * Millisecond);
+    EXPECT_FALSE(records[1].isValid);
+
+    EXPECT_EQ(records[2].queryTime, 1022 * Millisecond);
+    ASSERT_TRUE(records[2].isValid);
+    EXPECT_EQ(records[2].sample.time, third.time);
+    ExpectNear(records[2].sample.unitVector, third.unitVector);
+}
+
+TEST(GazeRecording, RejectsAnotherFormat) {
+    RecordingWriter writer("Simulated");
+    writer.record(0, false);
+    auto data = writer.finish();
+
+    std::vector<RecordedGaze> records;
+    std::string trackerName;
+    data[0] = 'Y';
+    EXPECT_FALSE(ParseRecording(data.data(), data.size(), records, trackerName));
+    EXPECT_FALSE(ParseRecording(data.data(), sizeof(FileHeader) - 1, records, trackerName));
+}
+
+TEST(GazeRecording, RejectsATruncatedChunk) {
+    RecordingWriter writer("Simulated");
+    for (int i = 0; i < 10; i++) {
+        writer.record(i * 11 * Millisecond, true, LookingAt(i * 11 * Millisecond, {0.f, 0.f, -1.f}));
+    }
+    const auto data = writer.finish();
+
+    std::vector<RecordedGaze> records;
+    std::string trackerName;
+    EXPECT_FALSE(ParseRecording(data.data(), data.size() - 5, records, trackerName));
+}
+
+TEST(GazeReplay, ReturnsEachRecordInTurnAndLoops) {
+    std::vector<RecordedGaze> records(3);
+    for (int i = 0; i < 3; i++) {
+        records[i].queryTime = i * 10 * Millisecond;
+        records[i].isValid = i != 1;
+        records[i].sample = LookingAt(records[i].queryTime - 5 * Millisecond, {0.1f * i, 0.f, -1.f});
+    }
+
+    GazeReplay replay(records, false /* isRealTime */);
+    GazeSample sample;
+    ASSERT_TRUE(replay.getGazeSample(500 * Millisecond, sample));
+    // The sample keeps its recorded age.
+    EXPECT_EQ(sample.time, 495 * Millisecond);
+    EXPECT_FALSE(replay.getGazeSample(501 * Millisecond, sample));
+    ASSERT_TRUE(replay.getGazeSample(502 * Millisecond, sample));
+    EXPECT_NEAR(sample.unitVector.x, records[2].sample.unitVector.x, 1e-6f);
+    ASSERT_TRUE(replay.getGazeSample(503 * Millisecond, sample));
+    EXPECT_NEAR(sample.unitVector.x, records[0].sample.unitVector.x, 1e-6f);
+}
+
+TEST(GazeReplay, FollowsTheRecordedTimingInRealTime) {
+    std::vector<RecordedGaze> records(4);
+    for (int i = 0; i < 4; i++) {
+        records[i].queryTime = 1000 * Millisecond + i * 10 * Millisecond;
+        records[i].isValid = true;
+        records[i].sample = LookingAt(records[i].queryTime - 5 * Millisecond, {0.1f * i, 0.f, -1.f});
+    }
+
+    GazeReplay replay(records, true /* isRealTime */);
+    GazeSample sample;
+
+    // The recording starts with the first query.
+    ASSERT_TRUE(replay.getGazeSample(7000 * Millisecond, sample));
+    EXPECT_NEAR(sample.unitVector.x, records[0].sample.unitVector.x, 1e-6f);
+
+    // 25ms later is during the third record.
+    ASSERT_TRUE(replay.getGazeSample(7025 * Millisecond, sample));
+    EXPECT_NEAR(sample.unitVector.x, records[2].sample.unitVector.x, 1e-6f);
+    EXPECT_EQ(sample.time, 7025 * Millisecond - 5 * Millisecond - 5 * Millisecond);
+
+    // The recording lasts 31ms, after which it loops.
+    ASSERT_TRUE(replay.getGazeSample(7031 * Millisecond + 12 * Millisecond, sample));
+    EXPECT_NEAR(sample.unitVector.x, records[1].sample.unitVector.x, 1e-6f);
+
+    replay.restart();
+    ASSERT_TRUE(replay.getGazeSample(9000 * Millisecond, sample));
+    EXPECT_NEAR(sample.unitVector.x, records[0].sample.unitVector.x, 1e-6f);
+}
@@ -0,0 +1,134 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gaze_trajectory.h>
+
+using namespace openxr_api_layer;
+using namespace openxr_api_layer::synthetic;
+
+namespace {
+
+    constexpr XrDuration Millisecond = 1'000'000;
+    constexpr float RadiansToDegrees = 180.f / 3.14159265f;
+
+} // namespace
+
+TEST(GazeTrajectory, OnlyDependsOnTheSeedAndTime) {
+    GazeTrajectory dense(42);
+    GazeTrajectory sparse(42);
+    GazeTrajectory other(43);
+
+    bool isDifferent = false;
+    for (XrDuration time = 0; time < 10'000 * Millisecond; time += Millisecond) {
+        GazeAngles a, b;
+        const bool isOpen = dense.evaluate(time, a);
+        if (time % (97 * Millisecond) == 0) {
+            EXPECT_EQ(sparse.evaluate(time, b), isOpen);
+            EXPECT_EQ(a.yaw, b.yaw);
+            EXPECT_EQ(a.pitch, b.pitch);
+
+            GazeAngles c;
+            other.evaluate(time, c);
+            isDifferent = isDifferent || c.yaw != a.yaw;
+        }
+    }
+    EXPECT_TRUE(isDifferent);
+}
+
+TEST(GazeTrajectory, CanBeQueriedBackInTime) {
+    GazeTrajectory trajectory(7);
+    GazeAngles early, late, again;
+    trajectory.evaluate(1234 * Millisecond, early);
+    trajectory.evaluate(30'000 * Millisecond, late);
+    trajectory.evaluate(1234 * Millisecond, again);
+    EXPECT_EQ(early.yaw, again.yaw);
+    EXPECT_EQ(early.pitch, again.pitch);
+}
+
+TEST(GazeTrajectory, IsPhysiologicallyPlausible) {
+    GazeTrajectory trajectory(1);
+    const XrDuration step = Millisecond;
+    const XrDuration duration = 120'000 * Millisecond;
+
+    GazeAngles previous;
+    trajectory.evaluate(0, previous);
+    float maxVelocity = 0.f;
+    int blinks = 0;
+    XrDuration fixationTime = 0;
+    MovementType previousType = MovementType::Fixation;
+    for (XrDuration time = step; time < duration; time += step) {
+        GazeAngles angles;
+        trajectory.evaluate(time, angles);
+        EXPECT_LE(std::abs(angles.yaw) * RadiansToDegrees, 25.f + 1e-3f);
+        EXPECT_LE(std::abs(angles.pitch) * RadiansToDegrees, 20.f + 1e-3f);
+
+        const float velocity =
+            std::hypot(angles.yaw - previous.yaw, angles.pitch - previous.pitch) * RadiansToDegrees / 1e-3f;
+        maxVelocity = std::max(maxVelocity, velocity);
+        previous = angles;
+
+        const MovementType type = trajectory.getMovementType(time);
+        blinks += type == MovementType::Blink && previousType != MovementType::Blink;
+        fixationTime += type == MovementType::Fixation ? step : 0;
+        previousType = type;
+    }
+
+    // Saccades peak below 700 degrees per second, and about 15 blinks per minute.
+    EXPECT_LT(maxVelocity, 700.f);
+    EXPECT_GT(maxVelocity, 200.f);
+    EXPECT_GT(blinks, 20);
+    EXPECT_LT(blinks, 45);
+    // The gaze is fixating most of the time.
+    EXPECT_GT(fixationTime, duration / 2);
+}
+
+TEST(SyntheticGaze, ReportsNoisyLateSamples) {
+    SyntheticGaze gaze(5, 20 * Millisecond);
+    EXPECT_EQ(gaze.getLatency(), 20 * Millisecond);
+
+    int samples = 0;
+    float totalError = 0.f;
+    for (XrTime time = 1000 * Millisecond; time < 11'000 * Millisecond; time += 11 * Millisecond) {
+        GazeSample sample;
+        if (!gaze.getGazeSample(time, sample)) {
+            continue;
+        }
+        ASSERT_TRUE(sample.isValid);
+        EXPECT_EQ(sample.time, time - 20 * Millisecond);
+        EXPECT_NEAR(gaze::Dot(sample.unitVector, sample.unitVector), 1.f, 1e-5f);
+
+        // The sample is the true gaze at the time it was captured, with some noise.
+        const XrVector3f truth = gaze.getTrueGaze(sample.time);
+        const float error = std::acos(std::min(gaze::Dot(sample.unitVector, truth), 1.f)) * RadiansToDegrees;
+        EXPECT_LT(error, 2.f);
+        totalError += error;
+        samples++;
+    }
+    ASSERT_GT(samples, 0);
+    EXPECT_GT(totalError / samples, 0.05f);
+    EXPECT_LT(totalError / samples, 0.5f);
+}
@@ -0,0 +1,111 @@
+# MIT License
+#
+# Copyright(c) 2021-2023 Matthieu Bucchianeri
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this softwareand associated documentation files(the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions :
+#
+# The above copyright noticeand this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+# Generates the xrGetInstanceProcAddr() lookup of the layer for the tests and benchmarks, with each hook returning its
+# index instead of installing a wrapper.
+#
+# Usage: generate_name_switch.py <output header>
+
+import os
+import sys
+
+# Keep the source tree clean of compiled modules.
+sys.dont_write_bytecode = True
+
+cur_dir = os.path.abspath(os.path.dirname(__file__))
+sys.path.append(os.path.join(cur_dir, '..', 'openxr-api-layer', 'framework'))
+
+import layer_apis
+from name_switch import genNameSwitch
+
+# The functions the loader resolves through the layer: OpenXR 1.0 and 1.1, and the extensions in layer_apis.py.
+core_functions = [
+    'xrGetInstanceProcAddr', 'xrEnumerateApiLayerProperties', 'xrEnumerateInstanceExtensionProperties',
+    'xrCreateInstance', 'xrDestroyInstance', 'xrGetInstanceProperties', 'xrPollEvent', 'xrResultToString',
+    'xrStructureTypeToString', 'xrGetSystem', 'xrGetSystemProperties', 'xrEnumerateEnvironmentBlendModes',
+    'xrCreateSession', 'xrDestroySession', 'xrEnumerateReferenceSpaces', 'xrCreateReferenceSpace',
+    'xrGetReferenceSpaceBoundsRect', 'xrCreateActionSpace', 'xrLocateSpace', 'xrDestroySpace',
+    'xrEnumerateViewConfigurations', 'xrGetViewConfigurationProperties', 'xrEnumerateViewConfigurationViews',
+    'xrEnumerateSwapchainFormats', 'xrCreateSwapchain', 'xrDestroySwapchain', 'xrEnumerateSwapchainImages',
+    'xrAcquireSwapchainImage', 'xrWaitSwapchainImage', 'xrReleaseSwapchainImage', 'xrBeginSession', 'xrEndSession',
+    'xrRequestExitSession', 'xrWaitFrame', 'xrBeginFrame', 'xrEndFrame', 'xrLocateViews', 'xrStringToPath',
+    'xrPathToString', 'xrCreateActionSet', 'xrDestroyActionSet', 'xrCreateAction', 'xrDestroyAction',
+    'xrSuggestInteractionProfileBindings', 'xrAttachSessionActionSets', 'xrGetCurrentInteractionProfile',
+    'xrGetActionStateBoolean', 'xrGetActionStateFloat', 'xrGetActionStateVector2f', 'xrGetActionStatePose',
+    'xrSyncActions', 'xrEnumerateBoundSourcesForAction', 'xrGetInputSourceLocalizedName', 'xrApplyHapticFeedback',
+    'xrStopHapticFeedback', 'xrLocateSpaces',
+]
+extension_functions = [
+    'xrCreateEyeTrackerFB', 'xrDestroyEyeTrackerFB', 'xrGetEyeGazesFB', 'xrConvertWin32PerformanceCounterToTimeKHR',
+    'xrConvertTimeToWin32PerformanceCounterKHR', 'xrLocateSpacesKHR',
+]
+functions = core_functions + extension_functions
+
+# Same entries as DispatchGenCppOutputGenerator.genGetInstanceProcAddr().
+hooked = ['xrDestroyInstance', 'xrEnumerateInstanceExtensionProperties'] + layer_apis.override_functions
+for name in hooked:
+    if name not in functions:
+        raise Exception(f'{name}() is not a known OpenXR function')
+
+# Names of the same length that no single character tells apart, which the generator matches in turn.
+colliding = ['xrAbc', 'xrAbd', 'xrBbc']
+
+def genNames(names):
+    return ''.join(f'\t\t"{name}",\n' for name in names)
+
+def genResolver(function, names):
+    entries = [(name, [f'return {index};']) for index, name in enumerate(names)]
+    return f'''	inline int {function}(const char* name)
+	{{
+		const std::string_view apiName(name);
+{genNameSwitch(entries)}
+		return -1;
+	}}'''
+
+with open(sys.argv[1], 'w') as out:
+    out.write(f'''// *********** THIS FILE IS GENERATED - DO NOT EDIT ***********
+
+#pragma once
+
+#include <string_view>
+
+namespace openxr_api_layer::name_switch
+{{
+
+	// All the functions the loader resolves through the layer.
+	inline constexpr const char* FunctionNames[] = {{
+{genNames(functions)}	}};
+
+	// The functions with a hook, in the order of their index.
+	inline constexpr const char* HookedNames[] = {{
+{genNames(hooked)}	}};
+
+	inline constexpr const char* CollidingNames[] = {{
+{genNames(colliding)}	}};
+
+	// Return the index of the hook of the function, or -1 when it falls through to the runtime.
+{genResolver('ResolveHook', hooked)}
+
+{genResolver('ResolveColliding', colliding)}
+
+}} // namespace openxr_api_layer::name_switch
+''')
@@ -0,0 +1,115 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <mpsc_ring.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    struct Record {
+        uint32_t producer;
+        uint32_t sequence;
+    };
+
+} // namespace
+
+TEST(MpscRing, PopsInPushOrder) {
+    MpscRing<int, 4> ring;
+    EXPECT_FALSE(ring.hasPending());
+    EXPECT_FALSE(ring.tryPop([](int&) { FAIL(); }));
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(ring.tryPush([&](int& value) { value = i; }));
+    }
+    EXPECT_TRUE(ring.hasPending());
+
+    for (int i = 0; i < 3; i++) {
+        int popped = -1;
+        EXPECT_TRUE(ring.tryPop([&](int& value) { popped = value; }));
+        EXPECT_EQ(popped, i);
+    }
+    EXPECT_FALSE(ring.hasPending());
+}
+
+TEST(MpscRing, RejectsPushesWhenFull) {
+    MpscRing<int, 4> ring;
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(ring.tryPush([&](int& value) { value = i; }));
+    }
+    EXPECT_FALSE(ring.tryPush([](int&) { FAIL(); }));
+
+    // Popping frees a slot, and positions keep wrapping around the ring.
+    for (int round = 0; round < 10; round++) {
+        int popped = -1;
+        EXPECT_TRUE(ring.tryPop([&](int& value) { popped = value; }));
+        EXPECT_EQ(popped, round);
+        EXPECT_TRUE(ring.tryPush([&](int& value) { value = round + 4; }));
+        EXPECT_FALSE(ring.tryPush([](int&) {}));
+    }
+}
+
+TEST(MpscRing, ConcurrentProducersLoseNothingButDrops) {
+    constexpr uint32_t ProducerCount = 4;
+    constexpr uint32_t RecordsPerProducer = 50'000;
+
+    MpscRing<Record, 64> ring;
+    std::atomic<uint32_t> dropped{0};
+    std::atomic<uint32_t> runningProducers{ProducerCount};
+
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < ProducerCount; producer++) {
+        producers.emplace_back([&, producer] {
+            for (uint32_t sequence = 0; sequence < RecordsPerProducer; sequence++) {
+                if (!ring.tryPush([&](Record& record) { record = {producer, sequence}; })) {
+                    dropped++;
+                }
+            }
+            runningProducers--;
+        });
+    }
+
+    // Records from one producer arrive in order, possibly with gaps where they were dropped.
+    uint32_t received = 0;
+    int64_t lastSequence[ProducerCount];
+    std::fill(std::begin(lastSequence), std::end(lastSequence), -1);
+    while (runningProducers.load() || ring.hasPending()) {
+        ring.tryPop([&](Record& record) {
+            ASSERT_LT(record.producer, ProducerCount);
+            EXPECT_GT((int64_t)record.sequence, lastSequence[record.producer]);
+            lastSequence[record.producer] = record.sequence;
+            received++;
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_EQ(received + dropped.load(), ProducerCount * RecordsPerProducer);
+}
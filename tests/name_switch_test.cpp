@@ -0,0 +1,91 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <name_switch.gen.h>
+
+using namespace openxr_api_layer::name_switch;
+
+namespace {
+
+    int IndexOf(const char* const* begin, const char* const* end, const std::string& name) {
+        const auto it = std::find(begin, end, name);
+        return it != end ? (int)std::distance(begin, it) : -1;
+    }
+
+    // Every name that differs from a hooked one by a single character, or by its length, must resolve to the hook of
+    // that name if there is one, and fall through otherwise.
+    template <typename Resolver, size_t Count>
+    void CheckNearMisses(Resolver resolve, const char* const (&names)[Count]) {
+        const auto expected = [&](const std::string& name) { return IndexOf(names, names + Count, name); };
+
+        for (const char* hooked : names) {
+            const std::string name(hooked);
+            std::vector<std::string> nearMisses{name.substr(0, name.size() - 1), name + "s", name + "KHR", ""};
+            for (size_t i = 0; i < name.size(); i++) {
+                for (char replacement : {'#', 'A', 'S', 'e', 's'}) {
+                    std::string nearMiss = name;
+                    nearMiss[i] = replacement;
+                    nearMisses.push_back(nearMiss);
+                }
+            }
+
+            for (const auto& nearMiss : nearMisses) {
+                EXPECT_EQ(resolve(nearMiss.c_str()), expected(nearMiss)) << nearMiss;
+            }
+        }
+    }
+
+} // namespace
+
+TEST(NameSwitch, ResolvesEachHookedFunctionToItsHook) {
+    for (int i = 0; i < (int)std::size(HookedNames); i++) {
+        EXPECT_EQ(ResolveHook(HookedNames[i]), i) << HookedNames[i];
+    }
+}
+
+TEST(NameSwitch, LetsTheOtherFunctionsFallThrough) {
+    size_t fallThrough = 0;
+    for (const char* name : FunctionNames) {
+        const int expected = IndexOf(std::begin(HookedNames), std::end(HookedNames), name);
+        EXPECT_EQ(ResolveHook(name), expected) << name;
+        fallThrough += expected < 0;
+    }
+    EXPECT_EQ(fallThrough, std::size(FunctionNames) - std::size(HookedNames));
+}
+
+TEST(NameSwitch, LetsTheNearMissesFallThrough) {
+    CheckNearMisses(ResolveHook, HookedNames);
+}
+
+TEST(NameSwitch, MatchesTheNamesNoCharacterTellsApartInTurn) {
+    for (int i = 0; i < (int)std::size(CollidingNames); i++) {
+        EXPECT_EQ(ResolveColliding(CollidingNames[i]), i) << CollidingNames[i];
+    }
+    CheckNearMisses(ResolveColliding, CollidingNames);
+}
@@ -0,0 +1,203 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <osc.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // Builds OSC packets the way senders encode them.
+    class PacketBuilder {
+      public:
+        PacketBuilder& string(const std::string& value) {
+            m_data.insert(m_data.end(), value.begin(), value.end());
+            do {
+                m_data.push_back('\0');
+            } while (m_data.size() % 4);
+            return *this;
+        }
+
+        PacketBuilder& int32(uint32_t value) {
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                m_data.push_back((char)(value >> shift));
+            }
+            return *this;
+        }
+
+        PacketBuilder& float32(float value) {
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return int32(bits);
+        }
+
+        PacketBuilder& element(const std::vector<char>& element) {
+            int32((uint32_t)element.size());
+            m_data.insert(m_data.end(), element.begin(), element.end());
+            return *this;
+        }
+
+        PacketBuilder& bundle() {
+            return string("#bundle").int32(0).int32(1);
+        }
+
+        const std::vector<char>& data() const {
+            return m_data;
+        }
+
+      private:
+        std::vector<char> m_data;
+    };
+
+    std::vector<char> GazeMessage(float x, float y, float z) {
+        return PacketBuilder().string("/sl/eyeTrackedGazePoint").string(",fff").float32(x).float32(y).float32(z).data();
+    }
+
+    struct Received {
+        std::string address;
+        std::string typeTags;
+        std::vector<float> floats;
+    };
+
+    bool Parse(const std::vector<char>& packet, std::vector<Received>& received) {
+        return osc::ParsePacket(packet.data(), packet.size(), [&](const osc::Message& message) {
+            Received entry{std::string(message.address), std::string(message.typeTags), {}};
+            entry.floats.resize(message.typeTags.size());
+            if (!message.getFloats(entry.floats.data(), entry.floats.size())) {
+                entry.floats.clear();
+            }
+            received.push_back(entry);
+        });
+    }
+
+} // namespace
+
+TEST(Osc, ParsesAMessage) {
+    std::vector<Received> received;
+    ASSERT_TRUE(Parse(GazeMessage(0.1f, -0.2f, -0.97f), received));
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0].address, "/sl/eyeTrackedGazePoint");
+    EXPECT_EQ(received[0].typeTags, "fff");
+    ASSERT_EQ(received[0].floats.size(), 3u);
+    EXPECT_EQ(received[0].floats[0], 0.1f);
+    EXPECT_EQ(received[0].floats[1], -0.2f);
+    EXPECT_EQ(received[0].floats[2], -0.97f);
+}
+
+TEST(Osc, ParsesNestedBundles) {
+    PacketBuilder inner;
+    inner.bundle().element(GazeMessage(3.f, 4.f, 5.f));
+
+    PacketBuilder outer;
+    outer.bundle().element(GazeMessage(0.f, 1.f, 2.f)).element(inner.data());
+
+    std::vector<Received> received;
+    ASSERT_TRUE(Parse(outer.data(), received));
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0].floats[2], 2.f);
+    EXPECT_EQ(received[1].floats[0], 3.f);
+}
+
+TEST(Osc, ChecksTheArgumentTypes) {
+    const auto packet =
+        PacketBuilder().string("/sl/eyeTrackedGazePoint").string(",ffi").float32(1.f).float32(2.f).int32(3).data();
+
+    bool handled = false;
+    ASSERT_TRUE(osc::ParsePacket(packet.data(), packet.size(), [&](const osc::Message& message) {
+        float values[3];
+        EXPECT_FALSE(message.getFloats(values, 3));
+        EXPECT_FALSE(message.getFloats(values, 2));
+        handled = true;
+    }));
+    EXPECT_TRUE(handled);
+}
+
+TEST(Osc, AcceptsMessagesWithoutTypeTags) {
+    std::vector<Received> received;
+    ASSERT_TRUE(Parse(PacketBuilder().string("/ping").data(), received));
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0].address, "/ping");
+    EXPECT_TRUE(received[0].typeTags.empty());
+}
+
+TEST(Osc, RejectsMalformedPackets) {
+    std::vector<Received> received;
+    const auto message = GazeMessage(0.f, 0.f, -1.f);
+
+    // Truncated, or not padded to 4 bytes.
+    EXPECT_FALSE(Parse({message.begin(), message.begin() + 6}, received));
+    EXPECT_FALSE(Parse({message.begin(), message.end() - 1}, received));
+    // Missing terminator.
+    EXPECT_FALSE(Parse({'/', 'a', 'b', 'c'}, received));
+    // Not an address.
+    EXPECT_FALSE(Parse(PacketBuilder().string("sl").string(",").data(), received));
+    // Type tags not starting with ','.
+    EXPECT_FALSE(Parse(PacketBuilder().string("/sl").string("fff").data(), received));
+    // Element larger than the bundle.
+    auto bundle = PacketBuilder().bundle().element(message).data();
+    bundle[19] += 4;
+    EXPECT_FALSE(Parse(bundle, received));
+    // Not a bundle.
+    EXPECT_FALSE(Parse(PacketBuilder().string("#bundlx").int32(0).int32(0).data(), received));
+
+    EXPECT_TRUE(received.empty());
+}
+
+TEST(Osc, RejectsDeeplyNestedBundles) {
+    std::vector<char> packet = GazeMessage(0.f, 0.f, -1.f);
+    for (int depth = 0; depth < 16; depth++) {
+        packet = PacketBuilder().bundle().element(packet).data();
+    }
+
+    std::vector<Received> received;
+    EXPECT_FALSE(Parse(packet, received));
+}
+
+TEST(Osc, SurvivesCorruptedPackets) {
+    PacketBuilder builder;
+    builder.bundle().element(GazeMessage(0.f, 0.f, -1.f)).element(GazeMessage(1.f, 0.f, 0.f));
+    const std::vector<char> valid = builder.data();
+
+    // Flip random bytes and truncate at random; the parser must never read outside of the packet (run under a
+    // sanitizer to catch it).
+    std::mt19937 random(99);
+    for (int i = 0; i < 20'000; i++) {
+        std::vector<char> packet = valid;
+        const int flips = std::uniform_int_distribution<int>(1, 4)(random);
+        for (int flip = 0; flip < flips; flip++) {
+            packet[std::uniform_int_distribution<size_t>(0, packet.size() - 1)(random)] = (char)random();
+        }
+        packet.resize(std::uniform_int_distribution<size_t>(0, packet.size())(random));
+
+        std::vector<Received> received;
+        Parse(packet, received);
+        EXPECT_LE(received.size(), 2u);
+    }
+}
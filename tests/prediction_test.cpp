@@ -0,0 +1,277 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <gaze_trajectory.h>
+#include <prediction.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    constexpr XrDuration Millisecond = 1'000'000;
+
+    // A sample with both eyes looking at the given angles, as the synthetic gaze would report it without noise.
+    GazeSample SampleAt(XrTime time, const synthetic::GazeAngles& angles, bool isValid = true) {
+        GazeSample sample;
+        sample.time = time;
+        sample.unitVector = synthetic::FromAngles(angles);
+        for (uint32_t eye = 0; eye < EyeCount; eye++) {
+            sample.eyeUnitVector[eye] = sample.unitVector;
+        }
+        sample.orientation = gaze::OrientationFromUnitVector(sample.unitVector);
+        sample.isValid = isValid;
+        return sample;
+    }
+
+    float YawOf(const XrVector3f& unitVector) {
+        return std::atan2(unitVector.x, -unitVector.z);
+    }
+
+    float PitchOf(const XrVector3f& unitVector) {
+        return std::asin(unitVector.y);
+    }
+
+    // A smooth pursuit at a constant angular velocity (radians per second), sampled at 200Hz.
+    void FeedPursuit(IGazePredictor& predictor, float velocity, int count, XrTime& lastTime) {
+        for (int i = 0; i < count; i++) {
+            lastTime = i * 5 * Millisecond;
+            predictor.update(SampleAt(lastTime, {velocity * i * 0.005f, -0.5f * velocity * i * 0.005f}));
+        }
+    }
+
+    // The mean angular error (degrees) against the true gaze, during each type of movement, of the gaze at each frame
+    // of a synthetic session, without and with prediction. Frames where the movement changed since the sample was
+    // captured are not scored.
+    struct Score {
+        float raw[3]{};
+        float predicted[3]{};
+    };
+
+    Score ScorePredictor(IGazePredictor& predictor, uint64_t seed) {
+        constexpr XrDuration FramePeriod = 11'111'111;
+        SyntheticGaze gaze(seed, 20 * Millisecond);
+
+        double raw[3]{}, predicted[3]{};
+        int count[3]{};
+        XrTime lastSampleTime = 0;
+        for (int frame = 0; frame < 90 * 60; frame++) {
+            const XrTime time = 1'000 * Millisecond + frame * FramePeriod;
+            const XrVector3f truth = gaze.getTrueGaze(time);
+
+            GazeSample sample;
+            if (!gaze.getGazeSample(time, sample)) {
+                predictor.reset();
+                continue;
+            }
+            if (sample.time > lastSampleTime) {
+                predictor.update(sample);
+                lastSampleTime = sample.time;
+            }
+
+            GazePrediction prediction;
+            const auto movement = gaze.getMovementType(time);
+            if (!predictor.predict(time, prediction) || movement == synthetic::MovementType::Blink ||
+                gaze.getMovementType(sample.time) != movement) {
+                continue;
+            }
+
+            const auto error = [&](const XrVector3f& unitVector) {
+                return std::acos(std::min(gaze::Dot(unitVector, truth), 1.f)) * 180.f / 3.14159265f;
+            };
+            raw[(int)movement] += error(sample.unitVector);
+            predicted[(int)movement] += error(prediction.unitVector);
+            count[(int)movement]++;
+        }
+
+        Score score;
+        for (int movement = 0; movement < 3; movement++) {
+            EXPECT_GT(count[movement], 0);
+            score.raw[movement] = (float)(raw[movement] / count[movement]);
+            score.predicted[movement] = (float)(predicted[movement] / count[movement]);
+        }
+        return score;
+    }
+
+    constexpr int Fixation = (int)synthetic::MovementType::Fixation;
+    constexpr int Saccade = (int)synthetic::MovementType::Saccade;
+    constexpr int Pursuit = (int)synthetic::MovementType::Pursuit;
+
+    class PredictorTest : public ::testing::TestWithParam<PredictorType> {
+      protected:
+        void SetUp() override {
+            m_predictor = GetParam() == PredictorType::Kalman ? createKalmanPredictor()
+                                                               : createConstantVelocityPredictor();
+        }
+
+        std::unique_ptr<IGazePredictor> m_predictor;
+    };
+
+} // namespace
+
+TEST_P(PredictorTest, ReportsItsType) {
+    EXPECT_EQ(m_predictor->getType(), GetParam());
+}
+
+TEST_P(PredictorTest, CannotPredictWithoutSamples) {
+    GazePrediction prediction;
+    EXPECT_FALSE(m_predictor->predict(0, prediction));
+
+    m_predictor->update(SampleAt(0, {}, false));
+    EXPECT_FALSE(m_predictor->predict(0, prediction));
+}
+
+TEST_P(PredictorTest, HoldsAStillGaze) {
+    for (int i = 0; i < 20; i++) {
+        m_predictor->update(SampleAt(i * 5 * Millisecond, {0.2f, -0.1f}));
+    }
+
+    GazePrediction prediction;
+    ASSERT_TRUE(m_predictor->predict(120 * Millisecond, prediction));
+    EXPECT_NEAR(YawOf(prediction.unitVector), 0.2f, 1e-3f);
+    EXPECT_NEAR(PitchOf(prediction.unitVector), -0.1f, 1e-3f);
+}
+
+TEST_P(PredictorTest, ExtrapolatesAPursuit) {
+    XrTime lastTime;
+    FeedPursuit(*m_predictor, 1.f, 40, lastTime);
+    const float lastYaw = 39 * 0.005f;
+
+    GazePrediction prediction;
+    ASSERT_TRUE(m_predictor->predict(lastTime + 20 * Millisecond, prediction));
+    EXPECT_NEAR(YawOf(prediction.unitVector), lastYaw + 0.02f, 2e-3f);
+    EXPECT_NEAR(PitchOf(prediction.unitVector), -0.5f * (lastYaw + 0.02f), 2e-3f);
+    EXPECT_GE(prediction.uncertainty, 0.f);
+}
+
+TEST_P(PredictorTest, LimitsThePredictionHorizon) {
+    XrTime lastTime;
+    FeedPursuit(*m_predictor, 1.f, 40, lastTime);
+
+    GazePrediction near, far;
+    ASSERT_TRUE(m_predictor->predict(lastTime + 50 * Millisecond, near));
+    ASSERT_TRUE(m_predictor->predict(lastTime + 500 * Millisecond, far));
+    EXPECT_NEAR(YawOf(near.unitVector), YawOf(far.unitVector), 1e-6f);
+}
+
+TEST_P(PredictorTest, RestartsAfterAGap) {
+    XrTime lastTime;
+    FeedPursuit(*m_predictor, 2.f, 20, lastTime);
+
+    // The tracker lost the eyes for a while, and the gaze is now still.
+    const XrTime resumeTime = lastTime + 500 * Millisecond;
+    m_predictor->update(SampleAt(resumeTime, {-0.3f, 0.f}));
+
+    GazePrediction prediction;
+    ASSERT_TRUE(m_predictor->predict(resumeTime + 20 * Millisecond, prediction));
+    EXPECT_NEAR(YawOf(prediction.unitVector), -0.3f, 1e-3f);
+}
+
+TEST_P(PredictorTest, ResetsOnAnInvalidSample) {
+    XrTime lastTime;
+    FeedPursuit(*m_predictor, 1.f, 20, lastTime);
+    m_predictor->update(SampleAt(lastTime + 5 * Millisecond, {}, false));
+
+    GazePrediction prediction;
+    EXPECT_FALSE(m_predictor->predict(lastTime + 10 * Millisecond, prediction));
+}
+
+TEST_P(PredictorTest, IsLessCertainFurtherAhead) {
+    // A noisy tracker following a pursuit.
+    SyntheticGaze gaze(4, 0);
+    XrTime lastTime = 0;
+    for (int i = 0; i < 200; i++) {
+        GazeSample sample;
+        if (gaze.getGazeSample(1'000 * Millisecond + i * 5 * Millisecond, sample)) {
+            m_predictor->update(sample);
+            lastTime = sample.time;
+        }
+    }
+
+    GazePrediction now, near, far;
+    ASSERT_TRUE(m_predictor->predict(lastTime, now));
+    ASSERT_TRUE(m_predictor->predict(lastTime + 10 * Millisecond, near));
+    ASSERT_TRUE(m_predictor->predict(lastTime + 40 * Millisecond, far));
+    EXPECT_GT(near.uncertainty, now.uncertainty);
+    EXPECT_GT(far.uncertainty, near.uncertainty);
+}
+
+TEST_P(PredictorTest, CatchesUpWithSaccadesOnASyntheticSession) {
+    for (uint64_t seed = 1; seed <= 3; seed++) {
+        m_predictor->reset();
+        const Score score = ScorePredictor(*m_predictor, seed);
+        EXPECT_LT(score.predicted[Saccade], 0.8f * score.raw[Saccade]) << "seed " << seed;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Predictors,
+                         PredictorTest,
+                         ::testing::Values(PredictorType::ConstantVelocity, PredictorType::Kalman),
+                         [](const auto& info) {
+                             return info.param == PredictorType::Kalman ? "Kalman" : "ConstantVelocity";
+                         });
+
+TEST(KalmanPredictor, RestartsOnASaccade) {
+    auto predictor = createKalmanPredictor();
+    for (int i = 0; i < 20; i++) {
+        predictor->update(SampleAt(i * 5 * Millisecond, {}));
+    }
+
+    // A 20 degrees jump is far outside of what the motion model expects, the filter starts over from it.
+    predictor->update(SampleAt(20 * 5 * Millisecond, {0.35f, 0.f}));
+
+    GazePrediction prediction;
+    ASSERT_TRUE(predictor->predict(20 * 5 * Millisecond, prediction));
+    EXPECT_NEAR(YawOf(prediction.unitVector), 0.35f, 1e-4f);
+}
+
+TEST(KalmanPredictor, SmoothsMeasurementNoise) {
+    auto predictor = createKalmanPredictor();
+
+    // Alternate 0.3 degrees either side of a still gaze.
+    for (int i = 0; i < 100; i++) {
+        predictor->update(SampleAt(i * 5 * Millisecond, {(i % 2 ? 1.f : -1.f) * 0.005f, 0.f}));
+    }
+
+    GazePrediction prediction;
+    ASSERT_TRUE(predictor->predict(99 * 5 * Millisecond, prediction));
+    EXPECT_LT(std::abs(YawOf(prediction.unitVector)), 0.005f);
+}
+
+TEST(KalmanPredictor, FiltersTheNoiseOfASyntheticSession) {
+    for (uint64_t seed = 1; seed <= 3; seed++) {
+        auto kalman = createKalmanPredictor();
+        auto constantVelocity = createConstantVelocityPredictor();
+        const Score kalmanScore = ScorePredictor(*kalman, seed);
+        const Score constantVelocityScore = ScorePredictor(*constantVelocity, seed);
+
+        // Extrapolating the noise of each sample is what makes the constant velocity predictor worse during
+        // fixations.
+        EXPECT_LT(kalmanScore.predicted[Fixation], 0.7f * constantVelocityScore.predicted[Fixation]) << "seed " << seed;
+        EXPECT_LT(kalmanScore.predicted[Pursuit], 1.1f * kalmanScore.raw[Pursuit]) << "seed " << seed;
+    }
+}
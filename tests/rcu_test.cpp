@@ -0,0 +1,139 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <rcu.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    std::atomic<int> g_liveValues{0};
+
+    // Counts its live instances, to tell when retired values are reclaimed.
+    struct Tracked {
+        Tracked() {
+            g_liveValues++;
+        }
+        Tracked(const Tracked& other) : value(other.value) {
+            g_liveValues++;
+        }
+        ~Tracked() {
+            g_liveValues--;
+        }
+
+        uint64_t value{0};
+    };
+
+} // namespace
+
+TEST(RcuValue, ReadsTheLatestUpdate) {
+    RcuValue<Tracked> rcu;
+    EXPECT_EQ(rcu.read()->value, 0u);
+
+    rcu.update([](Tracked& t) { t.value = 7; });
+    EXPECT_EQ(rcu.read()->value, 7u);
+
+    rcu.update([](Tracked& t) { t.value++; });
+    EXPECT_EQ((*rcu.read()).value, 8u);
+}
+
+TEST(RcuValue, ReclaimsRetiredValuesOnceUnread) {
+    const int liveBefore = g_liveValues.load();
+    {
+        RcuValue<Tracked> rcu;
+        {
+            const auto guard = rcu.read();
+            rcu.update([](Tracked& t) { t.value = 1; });
+            rcu.update([](Tracked& t) { t.value = 2; });
+
+            // The guard still holds the original value, so nothing was reclaimed.
+            EXPECT_EQ(guard->value, 0u);
+            EXPECT_EQ(g_liveValues.load() - liveBefore, 3);
+        }
+
+        rcu.update([](Tracked& t) { t.value = 3; });
+        EXPECT_EQ(g_liveValues.load() - liveBefore, 1);
+        EXPECT_EQ(rcu.read()->value, 3u);
+    }
+    EXPECT_EQ(g_liveValues.load(), liveBefore);
+}
+
+TEST(RcuValue, GuardOnAnotherThreadDefersReclamation) {
+    const int liveBefore = g_liveValues.load();
+    RcuValue<Tracked> rcu;
+
+    std::atomic<bool> isReading{false};
+    std::atomic<bool> canRelease{false};
+    std::thread reader([&] {
+        const auto guard = rcu.read();
+        isReading.store(true);
+        while (!canRelease.load()) {
+            std::this_thread::yield();
+        }
+        EXPECT_EQ(guard->value, 0u);
+    });
+    while (!isReading.load()) {
+        std::this_thread::yield();
+    }
+
+    rcu.update([](Tracked& t) { t.value = 1; });
+    EXPECT_EQ(g_liveValues.load() - liveBefore, 2);
+
+    canRelease.store(true);
+    reader.join();
+
+    rcu.update([](Tracked& t) { t.value = 2; });
+    EXPECT_EQ(g_liveValues.load() - liveBefore, 1);
+}
+
+TEST(RcuValue, ConcurrentReadersSeeMonotonicValues) {
+    RcuValue<Tracked> rcu;
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&] {
+            uint64_t last = 0;
+            while (!done.load()) {
+                const auto guard = rcu.read();
+                EXPECT_GE(guard->value, last);
+                last = guard->value;
+            }
+        });
+    }
+
+    for (int i = 0; i < 20'000; i++) {
+        rcu.update([](Tracked& t) { t.value++; });
+    }
+    done.store(true);
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(rcu.read()->value, 20'000u);
+}
@@ -0,0 +1,102 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <seqlock.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    // Every field holds the same value, so a torn read shows up as fields that disagree.
+    struct Block {
+        uint64_t values[7];
+        uint32_t tail;
+    };
+
+    Block MakeBlock(uint64_t value) {
+        Block block;
+        for (auto& v : block.values) {
+            v = value;
+        }
+        block.tail = (uint32_t)value;
+        return block;
+    }
+
+    bool IsConsistent(const Block& block) {
+        for (const auto& v : block.values) {
+            if (v != block.values[0]) {
+                return false;
+            }
+        }
+        return block.tail == (uint32_t)block.values[0];
+    }
+
+} // namespace
+
+TEST(SeqLock, LoadsTheStoredValue) {
+    SeqLock<Block> lock(MakeBlock(3));
+    EXPECT_EQ(lock.load().values[0], 3u);
+
+    lock.store(MakeBlock(42));
+    Block block;
+    ASSERT_TRUE(lock.tryLoad(block));
+    EXPECT_TRUE(IsConsistent(block));
+    EXPECT_EQ(block.values[6], 42u);
+}
+
+TEST(SeqLock, DefaultConstructsTheValue) {
+    SeqLock<Block> lock;
+    const Block block = lock.load();
+    EXPECT_TRUE(IsConsistent(block));
+    EXPECT_EQ(block.values[0], 0u);
+}
+
+TEST(SeqLock, ReadersNeverSeeATornValue) {
+    SeqLock<Block> lock;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (uint64_t i = 1; i <= 200'000; i++) {
+            lock.store(MakeBlock(i));
+        }
+        done.store(true);
+    });
+
+    uint64_t last = 0;
+    while (!done.load()) {
+        Block block;
+        if (lock.tryLoad(block)) {
+            ASSERT_TRUE(IsConsistent(block));
+            // There is a single writer, so values only move forward.
+            ASSERT_GE(block.values[0], last);
+            last = block.values[0];
+        }
+    }
+    writer.join();
+
+    EXPECT_EQ(lock.load().values[0], 200'000u);
+}
@@ -0,0 +1,168 @@
+// MIT License
+//
+// Copyright(c) 2022-2023 Matthieu Bucchianeri
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this softwareand associated documentation files(the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and /or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright noticeand this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <trace.h>
+
+using namespace openxr_api_layer;
+
+namespace {
+
+    size_t Count(const std::string& text, const std::string& pattern) {
+        size_t count = 0;
+        for (size_t position = text.find(pattern); position != std::string::npos;
+             position = text.find(pattern, position + pattern.size())) {
+            count++;
+        }
+        return count;
+    }
+
+    std::string Write(const trace::Recorder& recorder, size_t& eventCount) {
+        std::ostringstream out;
+        eventCount = recorder.write(out);
+        return out.str();
+    }
+
+} // namespace
+
+TEST(TraceRecorder, WritesTheEventsOldestFirst) {
+    trace::Recorder recorder(16);
+    recorder.record('B', "xrWaitFrame");
+    recorder.record('i', "EyeGaze", {{"x", 0.25}, {"y", -0.5}});
+    recorder.record('E', "xrWaitFrame");
+
+    size_t eventCount;
+    const std::string json = Write(recorder, eventCount);
+    EXPECT_EQ(eventCount, 3u);
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+
+    const size_t begin = json.find("{\"name\":\"xrWaitFrame\",\"ph\":\"B\",\"ts\":0.000,");
+    const size_t instant = json.find("{\"name\":\"EyeGaze\",\"ph\":\"i\"");
+    const size_t end = json.find("{\"name\":\"xrWaitFrame\",\"ph\":\"E\"");
+    ASSERT_NE(begin, std::string::npos);
+    ASSERT_NE(instant, std::string::npos);
+    ASSERT_NE(end, std::string::npos);
+    EXPECT_LT(begin, instant);
+    EXPECT_LT(instant, end);
+    EXPECT_NE(json.find(",\"s\":\"t\",\"args\":{\"x\":0.250,\"y\":-0.500}}", instant), std::string::npos);
+}
+
+TEST(TraceRecorder, KeepsTheFirstValuesAndWritesNonFiniteOnesAsNull) {
+    trace::Recorder recorder(4);
+    recorder.record('i', "Values", {{"a", 1}, {"b", NAN}, {"c", INFINITY}, {"d", 4}, {"e", 5}});
+
+    size_t eventCount;
+    const std::string json = Write(recorder, eventCount);
+    EXPECT_EQ(eventCount, 1u);
+    EXPECT_NE(json.find("\"args\":{\"a\":1.000,\"b\":null,\"c\":null,\"d\":4.000}"), std::string::npos);
+    EXPECT_EQ(json.find("\"e\""), std::string::npos);
+}
+
+TEST(TraceRecorder, DropsTheSpanEndsThatLostTheirBeginning) {
+    trace::Recorder recorder(4);
+    recorder.record('B', "Outer");
+    recorder.record('B', "Inner");
+    recorder.record('E', "Inner");
+    recorder.record('E', "Outer");
+    // Overwrites the beginning of the outer span.
+    recorder.record('i', "Last");
+
+    size_t eventCount;
+    const std::string json = Write(recorder, eventCount);
+    EXPECT_EQ(eventCount, 3u);
+    EXPECT_EQ(json.find("Outer"), std::string::npos);
+    EXPECT_EQ(Count(json, "\"name\":\"Inner\""), 2u);
+    EXPECT_EQ(Count(json, "\"name\":\"Last\""), 1u);
+}
+
+TEST(TraceRecorder, KeepsTheSpansOfEachThreadBalanced) {
+    constexpr size_t Capacity = 64;
+    trace::Recorder recorder(Capacity);
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 1000; j++) {
+                recorder.record('B', "Frame");
+                recorder.record('i', "Sample", {{"index", (double)j}});
+                recorder.record('E', "Frame");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    size_t eventCount;
+    const std::string json = Write(recorder, eventCount);
+    EXPECT_GT(eventCount, 0u);
+    EXPECT_LE(eventCount, Capacity);
+    EXPECT_EQ(Count(json, "{\"name\":"), eventCount);
+    // Spans may still be open where the capture ends, but no span ends without a beginning.
+    EXPECT_GE(Count(json, "\"ph\":\"B\""), Count(json, "\"ph\":\"E\""));
+}
+
+TEST(TraceCapture, RecordsOnlyWhileCapturing) {
+    const auto path = std::filesystem::temp_directory_path() / "trace_test.json";
+
+    trace::Instant("BeforeCapture");
+    EXPECT_FALSE(trace::IsCapturing());
+    EXPECT_FALSE(trace::DumpCapture(path).has_value());
+
+    EXPECT_EQ(trace::StartCapture(8), 8u);
+    EXPECT_TRUE(trace::IsCapturing());
+    {
+        const trace::ScopedSpan span("Span");
+        trace::Instant("DuringCapture", {{"value", 1}});
+    }
+    trace::StopCapture();
+    EXPECT_FALSE(trace::IsCapturing());
+    trace::Instant("AfterCapture");
+
+    // The ring is kept when capturing again.
+    EXPECT_EQ(trace::StartCapture(1024), 8u);
+    trace::StopCapture();
+
+    const auto eventCount = trace::DumpCapture(path);
+    ASSERT_TRUE(eventCount.has_value());
+    EXPECT_EQ(*eventCount, 3u);
+
+    std::ifstream file(path);
+    const std::string json((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(Count(json, "\"name\":\"Span\""), 2u);
+    EXPECT_EQ(Count(json, "\"name\":\"DuringCapture\""), 1u);
+    EXPECT_EQ(json.find("BeforeCapture"), std::string::npos);
+    EXPECT_EQ(json.find("AfterCapture"), std::string::npos);
+    file.close();
+    std::filesystem::remove(path);
+
+    EXPECT_FALSE(trace::DumpCapture(path / "missing-directory" / "trace.json").has_value());
+}